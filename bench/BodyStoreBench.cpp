@@ -0,0 +1,180 @@
+// 刚体存储基准：对比旧版 GameObject 式的数组结构（AoS）与 BodyStore（SoA）
+// 在积分和边界碰撞两个逐体遍历上的耗时，以及两两重叠检测的耗时。
+#include "Physics.h"
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+
+namespace {
+
+// 模拟旧版 GameObject 的内存布局：位置藏在约 270 字节的 sf::Sprite 里，
+// 后面跟着速度、若干 bool 和一个 std::function 回调，整体约 300 字节
+struct LegacyObject {
+    float x, y;                         // sf::Sprite 中的位置
+    unsigned char spriteRest[264];      // sf::Sprite 其余字段（变换矩阵、顶点等）
+    float vx, vy;
+    float mass;
+    bool isStopped;
+    float angularVelocity;
+    float rotationDamping;
+    float rotation;
+    float radius;
+    bool isSpecial, hasTriggeredSpecial, hasBeenLaunched;
+    std::function<void(LegacyObject&)> onSpecialEffect;
+};
+
+// 与 PhysicsWorld::integrate 相同的积分逻辑
+void integrateLegacy(std::vector<LegacyObject>& objects, float dt) {
+    for (auto& o : objects) {
+        if (o.isStopped) continue;
+        o.hasBeenLaunched = true;
+        o.x += o.vx * dt;
+        o.y += o.vy * dt;
+        o.vx *= FRICTION_COEFFICIENT;
+        o.vy *= FRICTION_COEFFICIENT;
+        float speed = std::sqrt(o.vx * o.vx + o.vy * o.vy);
+        o.angularVelocity = -speed * ROTATION_FACTOR;
+        float rotation = o.rotation + o.angularVelocity * dt;
+        o.rotation = rotation >= 360.f ? rotation - 360.f : (rotation < 0.f ? rotation + 360.f : rotation);
+        if (std::abs(o.vx) < STOP_VELOCITY && std::abs(o.vy) < STOP_VELOCITY) {
+            o.isStopped = true;
+            o.vx = o.vy = o.angularVelocity = 0.f;
+        }
+    }
+}
+
+// 与 CollisionHandler::applyBoundaryCollisions 相同的边界处理
+void boundaryLegacy(std::vector<LegacyObject>& objects) {
+    for (auto& o : objects) {
+        if (o.x - o.radius < ARENA_LEFT || o.x + o.radius > ARENA_RIGHT) {
+            o.vx = -o.vx * REBOUND_COEFFICIENT;
+            o.x = std::max(o.radius, std::min(o.x, WINDOW_WIDTH - o.radius));
+        }
+        if (o.y - o.radius < ARENA_TOP || o.y + o.radius > ARENA_BOTTOM) {
+            o.vy = -o.vy * REBOUND_COEFFICIENT;
+            o.y = std::max(o.radius, std::min(o.y, WINDOW_HEIGHT - o.radius));
+        }
+    }
+}
+
+// 两两重叠检测（只读），返回重叠对数
+int overlapsLegacy(const std::vector<LegacyObject>& objects) {
+    int count = 0;
+    for (size_t i = 0; i < objects.size(); ++i) {
+        for (size_t j = i + 1; j < objects.size(); ++j) {
+            float dx = objects[i].x - objects[j].x;
+            float dy = objects[i].y - objects[j].y;
+            float r = objects[i].radius + objects[j].radius;
+            count += dx * dx + dy * dy < r * r;
+        }
+    }
+    return count;
+}
+
+int overlapsStore(const BodyStore& bodies) {
+    const size_t n = bodies.size();
+    const float* x = bodies.x.data();
+    const float* y = bodies.y.data();
+    const float* radius = bodies.radius.data();
+    int count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i + 1; j < n; ++j) {
+            float dx = x[i] - x[j];
+            float dy = y[i] - y[j];
+            float r = radius[i] + radius[j];
+            count += dx * dx + dy * dy < r * r;
+        }
+    }
+    return count;
+}
+
+template <typename Fn>
+double measureNs(Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+void runCase(size_t count) {
+    // 在场地内随机放置球体并给一个初速度，保证测量期间都在运动
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> px(ARENA_LEFT + 50.f, ARENA_RIGHT - 50.f);
+    std::uniform_real_distribution<float> py(ARENA_TOP + 50.f, ARENA_BOTTOM - 50.f);
+    std::uniform_real_distribution<float> pv(-200.f, 200.f);
+
+    std::vector<Body> initial;
+    for (size_t i = 0; i < count; ++i) {
+        Body body(px(rng), py(rng), ENEMY_RADIUS);
+        body.vx = pv(rng);
+        body.vy = pv(rng);
+        body.isStopped = false;
+        initial.push_back(body);
+    }
+
+    // 每轮模拟 200 帧，总体更新量约 5e7 次
+    const int frames = 200;
+    const int rounds = static_cast<int>(std::max<size_t>(1, 50000000 / (count * frames)));
+
+    double legacyNs = 0.0, storeNs = 0.0;
+    float checksum = 0.f;
+    for (int round = 0; round < rounds; ++round) {
+        std::vector<LegacyObject> legacy(count);
+        PhysicsWorld world;
+        world.continuousCollision = false;  // 旧版没有扫掠碰撞检测，只比较积分本身
+        world.bodies.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            const Body& b = initial[i];
+            LegacyObject& o = legacy[i];
+            o.x = b.x; o.y = b.y; o.vx = b.vx; o.vy = b.vy;
+            o.radius = b.radius; o.rotation = 0.f; o.isStopped = false;
+            world.addEnemy(b);
+        }
+
+        legacyNs += measureNs([&] {
+            for (int f = 0; f < frames; ++f) {
+                integrateLegacy(legacy, PHYSICS_DT);
+                boundaryLegacy(legacy);
+            }
+        });
+        storeNs += measureNs([&] {
+            for (int f = 0; f < frames; ++f) {
+                world.integrate(PHYSICS_DT);
+                CollisionHandler::applyBoundaryCollisions(world.bodies);
+            }
+        });
+        checksum += legacy[count / 2].x - world.bodies.x[count / 2];
+    }
+
+    const double updates = static_cast<double>(rounds) * frames * count;
+    std::printf("%8zu 体 | 积分+边界  AoS %7.2f ns/体  SoA %7.2f ns/体  加速 %5.2fx",
+                count, legacyNs / updates, storeNs / updates, legacyNs / storeNs);
+
+    // 两两检测为 O(n^2)，十万规模留给宽相位处理
+    if (count <= 1000) {
+        std::vector<LegacyObject> legacy(count);
+        BodyStore store;
+        for (size_t i = 0; i < count; ++i) {
+            legacy[i].x = initial[i].x; legacy[i].y = initial[i].y; legacy[i].radius = initial[i].radius;
+            store.insert(i, initial[i].x, initial[i].y, initial[i].radius, 1.f, 0);
+        }
+        const int repeats = static_cast<int>(std::max<size_t>(1, 20000000 / (count * count)));
+        int a = 0, b = 0;
+        double pairLegacy = measureNs([&] { for (int r = 0; r < repeats; ++r) a += overlapsLegacy(legacy); });
+        double pairStore = measureNs([&] { for (int r = 0; r < repeats; ++r) b += overlapsStore(store); });
+        const double pairs = static_cast<double>(repeats) * count * (count - 1) / 2;
+        std::printf(" | 两两检测  AoS %6.2f ns/对  SoA %6.2f ns/对%s",
+                    pairLegacy / pairs, pairStore / pairs, a == b ? "" : "（结果不一致！）");
+    }
+    std::printf("%s\n", checksum == 0.f ? "" : "（积分结果不一致！）");
+}
+
+} // namespace
+
+int main() {
+    for (size_t count : {6, 1000, 100000}) {
+        runCase(count);
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+// 宽相位基准：在中心区域内放置密集的球群，比较逐对检测、空间哈希和扫描裁剪
+// 在整段模拟（运动 -> 碰撞 -> 逐渐静止）中的每步耗时和精确检测次数。
+#include "Physics.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+// 在中心区域内按带抖动的网格放置 count 个球，整体朝同一方向缓慢移动
+PhysicsWorld makeCluster(size_t count) {
+    std::mt19937 rng(2024);
+    std::uniform_real_distribution<float> jitter(-0.2f, 0.2f);
+
+    const size_t side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<float>(count))));
+    const float spacing = CENTER_ZONE_WIDTH / static_cast<float>(side);
+    const float radius = std::min(ENEMY_RADIUS, spacing * 0.45f);
+
+    PhysicsWorld world;
+    world.bodies.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        Body body(CENTER_ZONE_X + (static_cast<float>(i % side) + 0.5f + jitter(rng)) * spacing,
+                  CENTER_ZONE_Y + (static_cast<float>(i / side) + 0.5f + jitter(rng)) * spacing,
+                  radius);
+        body.vx = 20.f + jitter(rng) * 20.f;
+        body.vy = 10.f + jitter(rng) * 20.f;
+        body.isStopped = false;
+        world.addEnemy(body);
+    }
+    return world;
+}
+
+void runCase(size_t count, BroadPhaseMode mode, const char* name) {
+    const int steps = 400;
+    PhysicsWorld world = makeCluster(count);
+    world.broadPhase = mode;
+
+    size_t pairTests = 0, contacts = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s < steps; ++s) {
+        world.step(PHYSICS_DT);
+        pairTests += world.stats.pairTests;
+        contacts += world.stats.contacts;
+    }
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%7zu 体  %-12s %10.1f us/步  %12.0f 检测/步  %9.1f 接触/步  活动 %zu  休眠 %zu\n",
+                count, name, us / steps, static_cast<double>(pairTests) / steps,
+                static_cast<double>(contacts) / steps,
+                world.stats.activeBodies, world.stats.sleepingBodies);
+}
+
+} // namespace
+
+int main() {
+    for (size_t count : {100, 1000, 4000, 20000}) {
+        // 逐对检测是 O(n^2)，大规模时跳过
+        if (count <= 1000) runCase(count, BroadPhaseMode::BruteForce, "逐对检测");
+        runCase(count, BroadPhaseMode::SpatialHash, "空间哈希");
+        runCase(count, BroadPhaseMode::SweepAndPrune, "扫描裁剪");
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+// 窄相位基准：对宽相位给出的候选对，比较逐对开方与批处理内核（标量 / SSE2 / AVX2）的耗时。
+// 各版本与标量版本的逐位一致性由 tests/NarrowPhaseCheck.cpp 检查。
+#include "Physics.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+// 旧做法：每对都先开方再比较
+void testPairsSqrt(const BodyStore& bodies, const std::vector<BodyPair>& pairs, float slop, std::uint8_t* near) {
+    for (size_t k = 0; k < pairs.size(); ++k) {
+        const BodyPair& p = pairs[k];
+        const float dx = bodies.x[p.a] - bodies.x[p.b];
+        const float dy = bodies.y[p.a] - bodies.y[p.b];
+        near[k] = std::sqrt(dx * dx + dy * dy) < bodies.radius[p.a] + bodies.radius[p.b] + slop;
+    }
+}
+
+// 密集球群：用空间哈希取出真实的候选对（大部分并不接触）
+BodyStore makeCluster(size_t count, std::vector<BodyPair>& pairs) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> jitter(-0.3f, 0.3f);
+    const size_t side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<float>(count))));
+    const float spacing = ENEMY_RADIUS * 2.2f;
+
+    BodyStore bodies;
+    for (size_t i = 0; i < count; ++i) {
+        bodies.insert(i, (static_cast<float>(i % side) + jitter(rng)) * spacing,
+                      (static_cast<float>(i / side) + jitter(rng)) * spacing, ENEMY_RADIUS, 1.f, 0);
+    }
+    SpatialHash hash;
+    hash.findPairs(bodies, pairs);
+    return bodies;
+}
+
+std::vector<SimdLevel> availableLevels() {
+    std::vector<SimdLevel> levels = {SimdLevel::Scalar};
+    if (NarrowPhase::supportedLevel() >= SimdLevel::SSE2) levels.push_back(SimdLevel::SSE2);
+    if (NarrowPhase::supportedLevel() >= SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+    return levels;
+}
+
+template <typename Fn>
+double measureNsPerPair(size_t pairs, int rounds, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) fn();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+           (static_cast<double>(pairs) * rounds);
+}
+
+} // namespace
+
+int main() {
+    std::printf("CPU 支持 %s，物理世界默认使用 %s\n", NarrowPhase::levelName(NarrowPhase::supportedLevel()),
+                NarrowPhase::levelName(NarrowPhase::bestLevel()));
+
+    std::vector<BodyPair> clusterPairs;
+    const BodyStore cluster = makeCluster(20000, clusterPairs);
+
+    // 耗时：每轮处理全部候选对
+    const size_t count = clusterPairs.size();
+    const int rounds = static_cast<int>(std::max<size_t>(1, 50000000 / count));
+    std::vector<float> squared(count);
+    std::vector<std::uint8_t> near(count);
+    size_t nearCount = 0;
+
+    const double sqrtNs = measureNsPerPair(count, rounds, [&] {
+        testPairsSqrt(cluster, clusterPairs, SLEEP_CONTACT_SLOP, near.data());
+        nearCount += near[count / 2];
+    });
+    std::printf("%8zu 对  %-8s %6.2f ns/对\n", count, "逐对开方", sqrtNs);
+
+    for (SimdLevel level : availableLevels()) {
+        const double ns = measureNsPerPair(count, rounds, [&] {
+            NarrowPhase::testPairs(cluster, clusterPairs.data(), count, SLEEP_CONTACT_SLOP,
+                                   squared.data(), near.data(), level);
+            nearCount += near[count / 2];
+        });
+        std::printf("%8zu 对  %-8s %6.2f ns/对  (%.2fx)\n", count, NarrowPhase::levelName(level), ns, sqrtNs / ns);
+    }
+
+    std::printf("(校验和 %zu)\n", nearCount);
+    return 0;
+}
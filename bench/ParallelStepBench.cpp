@@ -0,0 +1,78 @@
+// 并行步进基准：同一个密集球群分别用单线程和不同线程数的任务系统模拟，
+// 比较每步耗时，并核对最终状态的哈希是否完全相同（与线程数无关），不同时返回非零。
+#include "Physics.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// 与 BroadPhaseBench 相同的球群：中心区域内带抖动的网格，整体朝同一方向缓慢移动
+PhysicsWorld makeCluster(size_t count) {
+    std::mt19937 rng(2024);
+    std::uniform_real_distribution<float> jitter(-0.2f, 0.2f);
+
+    const size_t side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<float>(count))));
+    const float spacing = CENTER_ZONE_WIDTH / static_cast<float>(side);
+    const float radius = std::min(ENEMY_RADIUS, spacing * 0.45f);
+
+    PhysicsWorld world;
+    world.bodies.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        Body body(CENTER_ZONE_X + (static_cast<float>(i % side) + 0.5f + jitter(rng)) * spacing,
+                  CENTER_ZONE_Y + (static_cast<float>(i / side) + 0.5f + jitter(rng)) * spacing,
+                  radius);
+        body.vx = 20.f + jitter(rng) * 20.f;
+        body.vy = 10.f + jitter(rng) * 20.f;
+        body.isStopped = false;
+        world.addEnemy(body);
+    }
+    return world;
+}
+
+// threads 为 0 时不使用任务系统
+std::uint64_t runCase(size_t count, unsigned threads, int steps) {
+    PhysicsWorld world = makeCluster(count);
+    std::unique_ptr<JobSystem> jobs;
+    if (threads > 0) {
+        jobs = std::make_unique<JobSystem>(threads);
+        world.jobs = jobs.get();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s < steps; ++s) {
+        world.step(PHYSICS_DT);
+    }
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    const std::uint64_t hash = world.stateHash();
+    std::printf("%7zu 体  %-10s %10.1f us/步  哈希 %016llx\n", count,
+                threads == 0 ? "无任务系统" : (std::to_string(threads) + " 线程").c_str(),
+                us / steps, static_cast<unsigned long long>(hash));
+    return hash;
+}
+
+} // namespace
+
+int main() {
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("硬件线程数: %u\n", hardware);
+
+    bool deterministic = true;
+    for (size_t count : {4000, 20000}) {
+        const std::uint64_t reference = runCase(count, 0, 200);
+        std::vector<unsigned> threadCounts = {1, 2, 4};
+        if (hardware > 4) threadCounts.push_back(hardware);
+        for (unsigned threads : threadCounts) {
+            deterministic &= runCase(count, threads, 200) == reference;
+        }
+    }
+
+    std::printf("%s\n", deterministic ? "各线程数结果逐位相同" : "结果与线程数有关！");
+    return deterministic ? 0 : 1;
+}
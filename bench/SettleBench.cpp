@@ -0,0 +1,93 @@
+// 停止预测基准：用随机种子和随机击球打若干整局（每次击球在所有球停止后发出，与 SeedRun 相同），
+// 分别关闭停止预测、使用游戏中的阈值和无显示批量模拟的阈值，核对最终状态哈希和得分与完整模拟相同，
+// 并比较总步数和耗时。任一阈值下最终状态与完整模拟不同时返回非零。
+//
+// 用法: SettleBench [--check]
+//   --check  只打前 20 局，作为 ctest 的准确性检查（SettleAccuracy）
+#include "Physics.h"
+#include "Random.h"
+#include "SimulationClock.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+struct Shot {
+    std::size_t player = 0;
+    float targetX = 0.f;
+    float targetY = 0.f;
+    float charge = 0.f;
+};
+
+struct RoundResult {
+    std::uint64_t hash = 0;
+    int score = 0;
+    std::uint64_t steps = 0;
+};
+
+RoundResult playRound(std::uint64_t seed, const std::vector<Shot>& shots, float settleDistance) {
+    PhysicsWorld world;
+    world.settleDistance = settleDistance;
+    world.spawnEnemies(seed);
+    world.spawnPlayers();
+
+    const float dt = SimulationClock().stepDt();
+    RoundResult result;
+    for (const Shot& shot : shots) {
+        world.launchPlayer(shot.player, shot.targetX, shot.targetY, shot.charge);
+        for (int s = 0; s < 1000000 && !world.allStopped(); ++s) {
+            world.step(dt);
+            result.steps++;
+        }
+    }
+    result.hash = world.stateHash();
+    result.score = world.countEnemiesOutsideZone();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool check = argc > 1 && std::strcmp(argv[1], "--check") == 0;
+    if (argc > 1 && !check) {
+        std::fprintf(stderr, "用法: %s [--check]\n", argv[0]);
+        return 2;
+    }
+    const int rounds = check ? 20 : 200;
+    const float distances[] = {0.f, SETTLE_DISTANCE, SETTLE_HEADLESS_DISTANCE};
+    RoundResult totals[3];
+    double seconds[3] = {};
+    int mismatches[3] = {};
+
+    SimRandom random(2024);
+    for (int round = 0; round < rounds; ++round) {
+        // 四只鸟依次朝中心区域附近的随机点发射
+        const std::uint64_t seed = random.next();
+        std::vector<Shot> shots;
+        for (std::size_t player = 0; player < 4; ++player) {
+            shots.push_back({player, CENTER_ZONE_X + CENTER_ZONE_WIDTH * random.uniform(),
+                             CENTER_ZONE_Y + CENTER_ZONE_HEIGHT * random.uniform(),
+                             0.5f + (CHARGE_MAX_TIME - 0.5f) * random.uniform()});
+        }
+
+        RoundResult results[3];
+        for (int k = 0; k < 3; ++k) {
+            const auto start = std::chrono::steady_clock::now();
+            results[k] = playRound(seed, shots, distances[k]);
+            seconds[k] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            totals[k].steps += results[k].steps;
+            if (results[k].hash != results[0].hash || results[k].score != results[0].score) mismatches[k]++;
+        }
+    }
+
+    std::printf("%d 局随机对局\n", rounds);
+    for (int k = 0; k < 3; ++k) {
+        std::printf("阈值 %5.1f 像素  总步数 %10llu (%5.1f%%)  耗时 %8.1f ms  最终状态不同 %d 局\n", distances[k],
+                    static_cast<unsigned long long>(totals[k].steps), 100.0 * totals[k].steps / totals[0].steps,
+                    seconds[k] * 1000.0, mismatches[k]);
+    }
+    return mismatches[1] + mismatches[2] == 0 ? 0 : 1;
+}
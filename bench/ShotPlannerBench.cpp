@@ -0,0 +1,39 @@
+// 击球规划基准：在若干种子的开局上以不同的时间预算和线程数运行 ShotPlanner，
+// 输出找到的最高得分、完成的候选数和实际耗时（应不超过预算加一个检查间隔）。
+#include "ShotPlanner.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main() {
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts = {0};
+    if (hardware > 1) threadCounts.push_back(hardware);
+    const int budgets[] = {10, 50, 200};
+
+    std::printf("%6s %-10s %8s %6s %8s %10s\n", "种子", "线程", "预算ms", "得分", "候选", "耗时ms");
+    for (std::uint64_t seed = 1; seed <= 6; ++seed) {
+        PhysicsWorld world;
+        world.spawnEnemies(seed);
+        world.spawnPlayers();
+        WorldSnapshot start;
+        world.saveSnapshot(start);
+
+        for (unsigned threads : threadCounts) {
+            std::unique_ptr<JobSystem> jobs;
+            if (threads > 0) jobs = std::make_unique<JobSystem>(threads);
+            ShotPlanner planner(jobs.get());
+            for (int budget : budgets) {
+                const ShotPlan plan = planner.plan(start, seed, std::chrono::milliseconds(budget));
+                std::printf("%6llu %-10s %8d %6d %8zu %10.1f\n", static_cast<unsigned long long>(seed),
+                            threads == 0 ? "无任务系统" : (std::to_string(threads) + " 线程").c_str(), budget,
+                            plan.score, plan.candidates, plan.milliseconds);
+            }
+        }
+    }
+    return 0;
+}
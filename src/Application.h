@@ -0,0 +1,133 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include "AssetLoader.h"
+#include "TextureManager.h"
+#include "Scene.h"
+#include "Menu.h"
+#include "Game.h"
+
+// 应用程序类：拥有唯一的窗口、资源加载器、纹理缓存和字体，
+// 在菜单和游戏两个场景之间切换（状态机），切换时窗口和已上传的资源都保留
+class Application {
+private:
+    // 资源加载（最先构造，窗口创建期间即开始解码）
+    sf::Clock startupClock;               // 从构造或切换场景开始计时，用于统计首帧耗时
+    bool firstFrameShown;                 // 当前场景是否已显示首帧
+    AssetLoader assets;                   // 后台资源加载
+
+    // 各场景共享的窗口和资源
+    sf::RenderWindow window;              // 主窗口
+    sf::Image icon;                       // 窗口图标
+    TextureManager textures;              // 纹理缓存
+    sf::Font font;                        // 字体
+    SceneContext context;                 // 传给各场景的共享资源
+
+    // 场景
+    std::unique_ptr<Scene> scene;         // 当前场景
+    sf::Clock frameClock;                 // 帧计时器
+
+    // 切换场景：先销毁旧场景再释放无人引用的纹理，同一时刻只有一个场景的资源在显存中
+    void switchScene(SceneId id) {
+        scene->onExit();
+        scene.reset();
+        textures.purgeUnused();
+
+        startupClock.restart();
+        firstFrameShown = false;
+        scene = createScene(id);
+        frameClock.restart();
+    }
+
+    std::unique_ptr<Scene> createScene(SceneId id) {
+        if (id == SceneId::Play) {
+            return std::make_unique<Game>(context);
+        }
+        return std::make_unique<MenuScene>(context);
+    }
+
+    // 处理所有待处理的输入事件
+    void processEvents() {
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            handleEvent(event);
+        }
+    }
+
+    void handleEvent(const sf::Event& event) {
+        if (event.type == sf::Event::Closed) {
+            window.close();
+            return;
+        }
+        scene->handleEvent(event);
+    }
+
+public:
+    // 构造函数：创建窗口并加载共享资源，从菜单开始
+    Application()
+            : firstFrameShown(false),
+              textures(&assets),
+              context{window, assets, textures, font} {
+        // 菜单图片在创建窗口之前就开始后台解码
+        assets.prefetchImage(ENEMY_TEXTURE_FILE);
+        for (const char* file : MENU_IMAGE_FILES) {
+            assets.prefetchImage(file);
+        }
+        window.create(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), L"哐哐当当雀雀球");
+        window.setFramerateLimit(60);
+
+        // 加载并设置窗口图标
+        if (assets.copyImage(ENEMY_TEXTURE_FILE, icon)) {
+            window.setIcon(icon.getSize().x, icon.getSize().y, icon.getPixelsPtr());
+        }
+
+        // 加载字体（菜单和游戏共用）
+        if (!font.loadFromFile("chinese.ttf")) {
+            throw std::runtime_error("Failed to load font!");
+        }
+
+        scene = createScene(SceneId::Menu);
+    }
+
+    // 运行应用程序
+    void run() {
+        frameClock.restart();
+        while (window.isOpen()) {
+            // 画面没有变化时阻塞等待下一个事件，空闲时几乎不占用 CPU 和 GPU
+            if (!scene->needsRedraw()) {
+                sf::Event event;
+                if (window.waitEvent(event)) {
+                    handleEvent(event);
+                }
+            }
+            processEvents();
+            scene->update(frameClock.restart().asSeconds());
+
+            if (scene->nextScene() != SceneId::None) {
+                switchScene(scene->nextScene());
+                continue;
+            }
+
+            if (window.isOpen() && scene->needsRedraw()) {
+                scene->render();
+                if (!firstFrameShown) {
+                    firstFrameShown = true;
+                    std::cout << "场景首帧耗时: " << startupClock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+                }
+            }
+        }
+        scene->onExit();
+
+        const AssetLoaderStats loaderStats = assets.getStats();
+        std::cout << "资源加载: 后台解码 " << loaderStats.decoded << " 个，共 " << loaderStats.decodeMilliseconds
+                  << " ms；主线程等待 " << loaderStats.waits << " 次，共 " << loaderStats.waitMilliseconds << " ms"
+                  << std::endl;
+
+        const TextureCacheStats& textureStats = textures.getStats();
+        std::cout << "纹理缓存: 命中 " << textureStats.hits << " 次，解码 " << textureStats.misses
+                  << " 次，共 " << textureStats.decodeMilliseconds << " ms" << std::endl;
+    }
+};
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 解码后的音效采样（主线程再用 sf::SoundBuffer::loadFromSamples 上传）
+struct SoundSamples {
+    std::vector<sf::Int16> samples;     // 交错存放的 16 位采样
+    unsigned channelCount = 0;          // 声道数
+    unsigned sampleRate = 0;            // 采样率
+};
+
+// 资源加载统计
+struct AssetLoaderStats {
+    size_t decoded = 0;                 // 后台解码的文件数
+    double decodeMilliseconds = 0.0;    // 工作线程解码总耗时
+    size_t waits = 0;                   // 取结果时还没解码完、主线程需要等待的次数
+    double waitMilliseconds = 0.0;      // 主线程等待总耗时（即加载造成的卡顿）
+};
+
+// 后台资源加载：工作线程只做读文件和解码（纯 CPU），
+// 主线程取结果时再上传到显卡或音频设备（OpenGL 上下文只在主线程使用）。
+// 提前调用 prefetch* 让解码与当前页面的渲染重叠，用到时通常已经解码完成
+class AssetLoader {
+public:
+    explicit AssetLoader(unsigned threads = 2) {
+        for (unsigned i = 0; i < std::max(1u, threads); ++i) {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~AssetLoader() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // 请求在后台解码（同一文件只解码一次，已请求过时什么也不做）
+    void prefetchImage(const std::string& file) {
+        std::lock_guard<std::mutex> lock(mutex);
+        request(file, Kind::Image);
+    }
+
+    void prefetchSound(const std::string& file) {
+        std::lock_guard<std::mutex> lock(mutex);
+        request(file, Kind::Sound);
+    }
+
+    // 是否已经解码完成（不阻塞）
+    bool isReady(const std::string& file) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = assets.find(file);
+        return found != assets.end() && found->second->done;
+    }
+
+    // 取得解码后的图片：还没解码完时阻塞等待，没有请求过时先请求。失败时返回 nullptr。
+    // 返回的指针在 release 之前有效
+    const sf::Image* image(const std::string& file) {
+        Asset& asset = wait(file, Kind::Image);
+        return asset.ok ? &asset.image : nullptr;
+    }
+
+    const SoundSamples* sound(const std::string& file) {
+        Asset& asset = wait(file, Kind::Sound);
+        return asset.ok ? &asset.sound : nullptr;
+    }
+
+    // 主线程：取得图片并上传为纹理
+    bool uploadTexture(const std::string& file, sf::Texture& texture) {
+        const sf::Image* decoded = image(file);
+        return decoded && texture.loadFromImage(*decoded);
+    }
+
+    // 主线程：取得图片的副本（例如窗口图标）
+    bool copyImage(const std::string& file, sf::Image& target) {
+        const sf::Image* decoded = image(file);
+        if (!decoded) return false;
+        target = *decoded;
+        return true;
+    }
+
+    // 主线程：取得音效采样并上传到音效缓冲
+    bool uploadSound(const std::string& file, sf::SoundBuffer& buffer) {
+        const SoundSamples* decoded = sound(file);
+        return decoded && buffer.loadFromSamples(decoded->samples.data(), decoded->samples.size(),
+                                                 decoded->channelCount, decoded->sampleRate);
+    }
+
+    // 释放已解码的数据（上传后不再需要 CPU 上的副本）；还在解码的文件不受影响
+    void release(const std::string& file) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = assets.find(file);
+        if (found != assets.end() && found->second->done) {
+            assets.erase(found);
+        }
+    }
+
+    AssetLoaderStats getStats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+
+private:
+    enum class Kind {
+        Image,
+        Sound
+    };
+
+    // 一个资源文件的解码状态和结果
+    struct Asset {
+        Kind kind = Kind::Image;
+        bool done = false;              // 解码已结束（无论成功与否）
+        bool ok = false;                // 解码成功
+        sf::Image image;
+        SoundSamples sound;
+    };
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeUp;                     // 有新请求或需要退出
+    std::condition_variable finished;                   // 有资源解码结束
+    std::map<std::string, std::unique_ptr<Asset>> assets;  // 文件名 -> 资源（地址稳定）
+    std::deque<std::string> queue;                      // 等待解码的文件
+    std::vector<std::thread> workers;
+    AssetLoaderStats stats;
+    bool stopping = false;
+
+    // 调用前需持有 mutex
+    Asset& request(const std::string& file, Kind kind) {
+        std::unique_ptr<Asset>& slot = assets[file];
+        if (!slot) {
+            slot = std::make_unique<Asset>();
+            slot->kind = kind;
+            queue.push_back(file);
+            wakeUp.notify_one();
+        }
+        return *slot;
+    }
+
+    Asset& wait(const std::string& file, Kind kind) {
+        std::unique_lock<std::mutex> lock(mutex);
+        Asset& asset = request(file, kind);
+        if (!asset.done) {
+            sf::Clock waitClock;
+            finished.wait(lock, [&] { return asset.done; });
+            stats.waits++;
+            stats.waitMilliseconds += waitClock.getElapsedTime().asSeconds() * 1000.0;
+        }
+        if (!asset.ok) {
+            std::cerr << "Error loading asset from " << file << std::endl;
+        }
+        return asset;
+    }
+
+    static bool decodeSound(const std::string& file, SoundSamples& sound) {
+        sf::InputSoundFile input;
+        if (!input.openFromFile(file)) return false;
+        sound.samples.resize(static_cast<size_t>(input.getSampleCount()));
+        sound.samples.resize(static_cast<size_t>(input.read(sound.samples.data(), sound.samples.size())));
+        sound.channelCount = input.getChannelCount();
+        sound.sampleRate = input.getSampleRate();
+        return true;
+    }
+
+    void workerLoop() {
+        for (;;) {
+            std::string file;
+            Asset* asset = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeUp.wait(lock, [&] { return stopping || !queue.empty(); });
+                if (stopping) return;
+                file = std::move(queue.front());
+                queue.pop_front();
+                asset = assets[file].get();
+            }
+
+            // 解码时不持有锁（未完成的资源不会被 release 删除）
+            sf::Clock decodeClock;
+            const bool ok = asset->kind == Kind::Image ? asset->image.loadFromFile(file)
+                                                       : decodeSound(file, asset->sound);
+            const double milliseconds = decodeClock.getElapsedTime().asSeconds() * 1000.0;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                asset->ok = ok;
+                asset->done = true;
+                stats.decoded++;
+                stats.decodeMilliseconds += milliseconds;
+            }
+            finished.notify_all();
+        }
+    }
+};
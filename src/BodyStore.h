@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// 状态标志位
+enum BodyFlag : std::uint8_t {
+    BODY_STOPPED = 1 << 0,      // 停止状态
+    BODY_SPECIAL = 1 << 1,      // 特殊球
+    BODY_TRIGGERED = 1 << 2,    // 已触发特殊效果
+    BODY_LAUNCHED = 1 << 3,     // 已被发射
+    BODY_SLEEPING = 1 << 4      // 休眠：所在接触岛整体静止，不参与积分和碰撞
+};
+
+// 刚体存储：结构数组（SoA）布局，积分和碰撞只遍历用到的连续数组
+class BodyStore {
+public:
+    // 运动状态
+    std::vector<float> x, y;                    // 圆心位置
+    std::vector<float> vx, vy;                  // 速度
+    std::vector<float> rotation;                // 旋转角度（度）
+    std::vector<float> angularVelocity;         // 角速度
+    std::vector<float> prevX, prevY;            // 本步开始时的位置（扫掠包围盒和渲染插值）
+    std::vector<float> prevRotation;            // 本步开始时的旋转角度（渲染插值）
+
+    // 形状、质量和标志
+    std::vector<float> radius;                  // 半径
+    std::vector<float> mass;                    // 质量
+    std::vector<std::uint8_t> flags;            // BodyFlag 组合
+    std::vector<std::uint32_t> island;          // 休眠时所属的接触岛编号
+
+    std::size_t size() const {
+        return x.size();
+    }
+
+    void reserve(std::size_t n) {
+        forEachArray([n](auto& array) { array.reserve(n); });
+    }
+
+    void clear() {
+        forEachArray([](auto& array) { array.clear(); });
+    }
+
+    // 在 index 处插入一个新球体（默认静止）
+    void insert(std::size_t index, float px, float py, float r, float m, std::uint8_t f) {
+        x.insert(x.begin() + index, px);
+        y.insert(y.begin() + index, py);
+        vx.insert(vx.begin() + index, 0.f);
+        vy.insert(vy.begin() + index, 0.f);
+        rotation.insert(rotation.begin() + index, 0.f);
+        angularVelocity.insert(angularVelocity.begin() + index, 0.f);
+        radius.insert(radius.begin() + index, r);
+        mass.insert(mass.begin() + index, m);
+        flags.insert(flags.begin() + index, f);
+        prevX.insert(prevX.begin() + index, px);
+        prevY.insert(prevY.begin() + index, py);
+        prevRotation.insert(prevRotation.begin() + index, 0.f);
+        island.insert(island.begin() + index, 0);
+    }
+
+    // 读写单个标志位
+    bool test(std::size_t i, std::uint8_t flag) const {
+        return (flags[i] & flag) != 0;
+    }
+
+    void assign(std::size_t i, std::uint8_t flag, bool on) {
+        if (on) {
+            flags[i] |= flag;
+        } else {
+            flags[i] &= static_cast<std::uint8_t>(~flag);
+        }
+    }
+
+private:
+    template <typename Fn>
+    void forEachArray(Fn fn) {
+        fn(x); fn(y); fn(vx); fn(vy);
+        fn(rotation); fn(angularVelocity);
+        fn(prevX); fn(prevY); fn(prevRotation);
+        fn(radius); fn(mass); fn(flags); fn(island);
+    }
+};
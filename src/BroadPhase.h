@@ -0,0 +1,309 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <unordered_set>
+#include "BodyStore.h"
+
+// 宽相位：快速筛选出可能接触的球体对，再交给 CollisionHandler 做精确检测
+
+// 候选球体对（存储下标，a < b）
+struct BodyPair {
+    std::uint32_t a;
+    std::uint32_t b;
+
+    bool operator<(const BodyPair& other) const {
+        return a != other.a ? a < other.a : b < other.b;
+    }
+    bool operator==(const BodyPair& other) const {
+        return a == other.a && b == other.b;
+    }
+};
+
+// 空间哈希：把球心映射到边长等于最大直径的网格
+// （游戏中即 2 * max(PLAYER_RADIUS, ENEMY_RADIUS)），只有相邻（3x3）格子里的球才可能接触
+class SpatialHash {
+public:
+
+    float getCellSize() const {
+        return cellSize;
+    }
+
+    // 生成所有候选球体对（按下标排序，保证结果与遍历顺序无关），
+    // 两个球都带有 skipFlag（如休眠）的球体对不会生成
+    void findPairs(const BodyStore& bodies, std::vector<BodyPair>& pairs, std::uint8_t skipFlag = 0) {
+        pairs.clear();
+        build(bodies);
+        findPairsInRange(bodies, 0, bodies.size(), pairs, skipFlag);
+        std::sort(pairs.begin(), pairs.end());
+    }
+
+    // 把下标在 [begin, end) 内的球负责收集的候选对追加到 pairs（未排序）。
+    // 每对只由其中一个球收集，各区间互不重叠，可以分块并行后再合并；调用前需先 build
+    void findPairsInRange(const BodyStore& bodies, std::size_t begin, std::size_t end,
+                          std::vector<BodyPair>& pairs, std::uint8_t skipFlag = 0) const {
+        const std::uint8_t* flags = bodies.flags.data();
+        for (std::size_t i = begin; i < end; ++i) {
+            if (flags[i] & skipFlag) continue;
+
+            const std::int32_t cx = cellX[i];
+            const std::int32_t cy = cellY[i];
+            for (std::int32_t oy = -1; oy <= 1; ++oy) {
+                for (std::int32_t ox = -1; ox <= 1; ++ox) {
+                    const std::size_t bucket = bucketOf(cx + ox, cy + oy);
+                    for (std::uint32_t k = bucketStart[bucket]; k < bucketStart[bucket + 1]; ++k) {
+                        const std::uint32_t j = sortedBodies[k];
+                        // 被跳过的球只会从另一侧收集一次，其余只收集 j > i，并排除哈希冲突带来的其他格子
+                        if (j == i || (j < i && !(flags[j] & skipFlag))) continue;
+                        if (cellX[j] != cx + ox || cellY[j] != cy + oy) continue;
+                        pairs.push_back({static_cast<std::uint32_t>(std::min<std::size_t>(i, j)),
+                                         static_cast<std::uint32_t>(std::max<std::size_t>(i, j))});
+                    }
+                }
+            }
+        }
+    }
+
+    // 按当前球心位置重建网格（计数排序：把所有球按所在的桶连续排列）。
+    // findPairs 会自动调用；单独使用 findPairsInRange、forEachInBox 前需要先调用
+    void build(const BodyStore& bodies) {
+        const std::size_t n = bodies.size();
+
+        // 桶数取不小于 2n 的 2 的幂，使平均每桶少于一个球
+        std::size_t buckets = 16;
+        while (buckets < n * 2) buckets <<= 1;
+        bucketStart.assign(buckets + 1, 0);
+        cellX.resize(n);
+        cellY.resize(n);
+        sortedBodies.resize(n);
+
+        // 格子边长取场上最大直径，保证接触的球一定落在相邻格子里
+        float maxDiameter = 0.f;
+        for (std::size_t i = 0; i < n; ++i) {
+            maxDiameter = std::max(maxDiameter, bodies.radius[i] * 2.f);
+        }
+        cellSize = std::max(maxDiameter, 1e-3f);
+        const float inverseCellSize = 1.f / cellSize;
+
+        for (std::size_t i = 0; i < n; ++i) {
+            cellX[i] = static_cast<std::int32_t>(std::floor(bodies.x[i] * inverseCellSize));
+            cellY[i] = static_cast<std::int32_t>(std::floor(bodies.y[i] * inverseCellSize));
+            bucketStart[bucketOf(cellX[i], cellY[i]) + 1]++;
+        }
+        for (std::size_t b = 0; b < buckets; ++b) {
+            bucketStart[b + 1] += bucketStart[b];
+        }
+
+        std::vector<std::uint32_t>& cursor = scratch;
+        cursor.assign(bucketStart.begin(), bucketStart.end() - 1);
+        for (std::size_t i = 0; i < n; ++i) {
+            sortedBodies[cursor[bucketOf(cellX[i], cellY[i])]++] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    // 对球心落在矩形 [minX, maxX] x [minY, maxY] 所覆盖格子内的每个球调用 fn(下标)，
+    // 覆盖的格子数多于球数时直接遍历所有球
+    template <typename Fn>
+    void forEachInBox(float minX, float minY, float maxX, float maxY, Fn fn) const {
+        const float inverseCellSize = 1.f / cellSize;
+        const float x0 = std::floor(minX * inverseCellSize);
+        const float y0 = std::floor(minY * inverseCellSize);
+        const float x1 = std::floor(maxX * inverseCellSize);
+        const float y1 = std::floor(maxY * inverseCellSize);
+        const std::size_t n = sortedBodies.size();
+        if ((static_cast<double>(x1) - x0 + 1.0) * (static_cast<double>(y1) - y0 + 1.0) > static_cast<double>(n)) {
+            for (std::size_t i = 0; i < n; ++i) fn(i);
+            return;
+        }
+
+        for (std::int32_t cy = static_cast<std::int32_t>(y0); cy <= static_cast<std::int32_t>(y1); ++cy) {
+            for (std::int32_t cx = static_cast<std::int32_t>(x0); cx <= static_cast<std::int32_t>(x1); ++cx) {
+                const std::size_t bucket = bucketOf(cx, cy);
+                for (std::uint32_t k = bucketStart[bucket]; k < bucketStart[bucket + 1]; ++k) {
+                    const std::uint32_t j = sortedBodies[k];
+                    if (cellX[j] == cx && cellY[j] == cy) fn(j);
+                }
+            }
+        }
+    }
+
+private:
+    float cellSize = 0.f;                       // 本次使用的网格边长
+
+    std::vector<std::int32_t> cellX, cellY;     // 每个球所在的格子坐标
+    std::vector<std::uint32_t> bucketStart;     // 每个桶在 sortedBodies 中的起始位置
+    std::vector<std::uint32_t> sortedBodies;    // 按桶排序后的球体下标
+    std::vector<std::uint32_t> scratch;         // 计数排序的写入游标
+
+    std::size_t bucketOf(std::int32_t x, std::int32_t y) const {
+        const std::uint32_t h = static_cast<std::uint32_t>(x) * 73856093u ^
+                                static_cast<std::uint32_t>(y) * 19349663u;
+        return h & (bucketStart.size() - 2);
+    }
+
+};
+
+// 扫描裁剪（Sweep and Prune）：在两个轴上保存排好序的包围盒端点，帧间只做插入排序。
+// 球体运动连贯、大部分时间静止，每帧几乎没有端点交换；
+// 只有端点交换时才会改变球体对的重叠状态。
+class SweepAndPrune {
+public:
+    // 本次更新中新开始 / 结束重叠的球体对
+    std::vector<BodyPair> addedPairs;
+    std::vector<BodyPair> removedPairs;
+
+    // 当前所有包围盒重叠的球体对（按下标排序）
+    const std::vector<BodyPair>& pairs() const {
+        return pairList;
+    }
+
+    // 强制下次更新时重建（球体增删、下标变化时调用）
+    void invalidate() {
+        boxCount = SIZE_MAX;
+    }
+
+    // 用最新的球体位置更新端点并维护重叠对
+    void update(const BodyStore& bodies) {
+        addedPairs.clear();
+        removedPairs.clear();
+
+        const std::size_t n = bodies.size();
+        if (n != boxCount) {
+            rebuild(bodies);
+            return;
+        }
+
+        refreshBounds(bodies);
+        for (int axis = 0; axis < 2; ++axis) {
+            insertionSort(axis);
+        }
+
+        if (!addedPairs.empty() || !removedPairs.empty()) {
+            pairList.clear();
+            pairList.reserve(overlapping.size());
+            for (std::uint64_t key : overlapping) {
+                pairList.push_back(unpack(key));
+            }
+            std::sort(pairList.begin(), pairList.end());
+        }
+    }
+
+private:
+    // 轴上的端点：值、所属球体以及是否为上界
+    struct Endpoint {
+        float value;
+        std::uint32_t body : 31;
+        std::uint32_t isMax : 1;
+
+        // 数值相同时下界排在上界前面，使相切的包围盒也算作重叠
+        bool before(const Endpoint& other) const {
+            return value < other.value || (value == other.value && isMax < other.isMax);
+        }
+    };
+
+    std::size_t boxCount = SIZE_MAX;                    // 端点表对应的球体数量
+    std::vector<Endpoint> endpoints[2];                 // x、y 轴上的端点表
+    std::vector<float> boxMin[2], boxMax[2];            // 每个球体的包围盒
+    std::unordered_set<std::uint64_t> overlapping;      // 当前重叠的球体对
+    std::vector<BodyPair> pairList;                     // overlapping 的有序副本
+
+    static std::uint64_t pack(std::uint32_t a, std::uint32_t b) {
+        if (a > b) std::swap(a, b);
+        return (static_cast<std::uint64_t>(a) << 32) | b;
+    }
+
+    static BodyPair unpack(std::uint64_t key) {
+        return {static_cast<std::uint32_t>(key >> 32), static_cast<std::uint32_t>(key)};
+    }
+
+    bool boxesOverlap(std::uint32_t a, std::uint32_t b) const {
+        return boxMin[0][a] <= boxMax[0][b] && boxMin[0][b] <= boxMax[0][a] &&
+               boxMin[1][a] <= boxMax[1][b] && boxMin[1][b] <= boxMax[1][a];
+    }
+
+    void refreshBounds(const BodyStore& bodies) {
+        const std::size_t n = bodies.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            const float r = bodies.radius[i];
+            boxMin[0][i] = bodies.x[i] - r;
+            boxMax[0][i] = bodies.x[i] + r;
+            boxMin[1][i] = bodies.y[i] - r;
+            boxMax[1][i] = bodies.y[i] + r;
+        }
+        for (int axis = 0; axis < 2; ++axis) {
+            for (Endpoint& e : endpoints[axis]) {
+                e.value = e.isMax ? boxMax[axis][e.body] : boxMin[axis][e.body];
+            }
+        }
+    }
+
+    // 插入排序；端点每越过另一个端点一次，对应球体对在该轴上的重叠状态就翻转一次
+    void insertionSort(int axis) {
+        std::vector<Endpoint>& list = endpoints[axis];
+        for (std::size_t i = 1; i < list.size(); ++i) {
+            const Endpoint moving = list[i];
+            std::size_t j = i;
+            while (j > 0 && moving.before(list[j - 1])) {
+                const Endpoint& passed = list[j - 1];
+                if (!moving.isMax && passed.isMax) {
+                    // 下界越过上界向左：开始在该轴上重叠
+                    if (boxesOverlap(moving.body, passed.body) &&
+                        overlapping.insert(pack(moving.body, passed.body)).second) {
+                        addedPairs.push_back(unpack(pack(moving.body, passed.body)));
+                    }
+                } else if (moving.isMax && !passed.isMax) {
+                    // 上界越过下界向左：在该轴上分离
+                    if (overlapping.erase(pack(moving.body, passed.body))) {
+                        removedPairs.push_back(unpack(pack(moving.body, passed.body)));
+                    }
+                }
+                list[j] = passed;
+                --j;
+            }
+            list[j] = moving;
+        }
+    }
+
+    // 从头排序并用一次扫描找出所有重叠对
+    void rebuild(const BodyStore& bodies) {
+        const std::size_t n = bodies.size();
+        boxCount = n;
+        overlapping.clear();
+        for (int axis = 0; axis < 2; ++axis) {
+            boxMin[axis].resize(n);
+            boxMax[axis].resize(n);
+            endpoints[axis].resize(n * 2);
+            for (std::size_t i = 0; i < n; ++i) {
+                endpoints[axis][i * 2] = {0.f, static_cast<std::uint32_t>(i), 0};
+                endpoints[axis][i * 2 + 1] = {0.f, static_cast<std::uint32_t>(i), 1};
+            }
+        }
+        refreshBounds(bodies);
+        for (int axis = 0; axis < 2; ++axis) {
+            std::sort(endpoints[axis].begin(), endpoints[axis].end(),
+                      [](const Endpoint& a, const Endpoint& b) { return a.before(b); });
+        }
+
+        // 沿 x 轴扫描：遇到下界时与所有未结束的包围盒比较 y 轴
+        std::vector<std::uint32_t> open;
+        for (const Endpoint& e : endpoints[0]) {
+            if (e.isMax) {
+                open.erase(std::find(open.begin(), open.end(), e.body));
+                continue;
+            }
+            for (std::uint32_t other : open) {
+                if (boxesOverlap(e.body, other)) {
+                    overlapping.insert(pack(e.body, other));
+                    addedPairs.push_back(unpack(pack(e.body, other)));
+                }
+            }
+            open.push_back(e.body);
+        }
+
+        pairList = addedPairs;
+        std::sort(pairList.begin(), pairList.end());
+    }
+};
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// 二进制文件格式共用的读写工具：所有整数均为小端序，与平台字节序无关
+
+// 追加写入小端序数据
+struct ByteWriter {
+    std::vector<std::uint8_t> bytes;
+
+    void u8(std::uint8_t v) { bytes.push_back(v); }
+    void u16(std::uint16_t v) {
+        u8(static_cast<std::uint8_t>(v));
+        u8(static_cast<std::uint8_t>(v >> 8));
+    }
+    void u32(std::uint32_t v) {
+        u16(static_cast<std::uint16_t>(v));
+        u16(static_cast<std::uint16_t>(v >> 16));
+    }
+    void u64(std::uint64_t v) {
+        u32(static_cast<std::uint32_t>(v));
+        u32(static_cast<std::uint32_t>(v >> 32));
+    }
+    void f32(float v) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        u32(bits);
+    }
+    // zigzag 编码的变长有符号整数，每字节 7 位
+    void varint(std::int64_t v) {
+        std::uint64_t z = (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+        while (z >= 0x80) {
+            u8(static_cast<std::uint8_t>(z | 0x80));
+            z >>= 7;
+        }
+        u8(static_cast<std::uint8_t>(z));
+    }
+
+    // 回填已写入位置的 32 位整数（文件头中的长度和校验和）
+    void patchU32(std::size_t offset, std::uint32_t v) {
+        for (int k = 0; k < 4; ++k) {
+            bytes[offset + k] = static_cast<std::uint8_t>(v >> (8 * k));
+        }
+    }
+};
+
+// 带边界检查的读取：越界时返回 false，不读取任何数据
+struct ByteReader {
+    const std::uint8_t* pos;
+    const std::uint8_t* end;
+
+    std::size_t remaining() const { return static_cast<std::size_t>(end - pos); }
+
+    bool u8(std::uint8_t& v) {
+        if (pos == end) return false;
+        v = *pos++;
+        return true;
+    }
+    bool u16(std::uint16_t& v) {
+        if (remaining() < 2) return false;
+        v = loadU16(pos);
+        pos += 2;
+        return true;
+    }
+    bool u32(std::uint32_t& v) {
+        if (remaining() < 4) return false;
+        v = loadU32(pos);
+        pos += 4;
+        return true;
+    }
+    bool u64(std::uint64_t& v) {
+        std::uint32_t low = 0, high = 0;
+        if (!u32(low) || !u32(high)) return false;
+        v = (static_cast<std::uint64_t>(high) << 32) | low;
+        return true;
+    }
+    // 非有限值（NaN、无穷大）视为损坏
+    bool f32(float& v) {
+        std::uint32_t bits = 0;
+        if (!u32(bits)) return false;
+        std::memcpy(&v, &bits, sizeof(v));
+        return std::isfinite(v);
+    }
+    // 最多 5 个字节（32 位以内的值），更长的视为损坏
+    bool varint(std::int64_t& v) {
+        std::uint64_t z = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            std::uint8_t byte = 0;
+            if (!u8(byte)) return false;
+            z |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                v = static_cast<std::int64_t>(z >> 1) ^ -static_cast<std::int64_t>(z & 1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static std::uint16_t loadU16(const std::uint8_t* p) {
+        return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    static std::uint32_t loadU32(const std::uint8_t* p) {
+        return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+               (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+    }
+};
+
+// CRC-32（IEEE 802.3，与 zlib 相同）；crc 为前一段的结果时可以分段计算
+inline std::uint32_t crc32(const std::uint8_t* data, std::size_t size, std::uint32_t crc = 0) {
+    static const std::array<std::uint32_t, 256> table = [] {
+        std::array<std::uint32_t, 256> t{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+    crc ^= 0xFFFFFFFFu;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
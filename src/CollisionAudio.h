@@ -0,0 +1,108 @@
+#pragma once
+
+#include <SFML/Audio.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Physics.h"
+
+// 碰撞音效相关常量
+constexpr std::size_t COLLISION_VOICES = 8;           // 同时播放的碰撞音效上限
+constexpr std::size_t COLLISION_PLAYS_PER_FRAME = 3;  // 每帧最多新开始的碰撞音效
+constexpr float COLLISION_MIN_SPEED = 5.f;            // 接近速度低于该值的碰撞不发声
+constexpr float COLLISION_FULL_SPEED = LAUNCH_MAX_SPEED;  // 达到该接近速度时音量最大
+constexpr float COLLISION_PAIR_COOLDOWN = 0.12f;      // 同一对球两次发声的最小间隔（秒）
+
+// 碰撞音效：物理步内只收集碰撞事件（纯数据拷贝），每帧结束时统一处理。
+// 同一对球在一帧内的多次碰撞合并为最强的一次，按接近速度从大到小最多播放
+// COLLISION_PLAYS_PER_FRAME 个，音量随速度变化；声音从固定数量的声部中分配，
+// 没有空闲声部时抢占最早开始的那个，一帧内大量碰撞也不会创建新的声音对象
+class CollisionAudio {
+public:
+    void setBuffer(const sf::SoundBuffer& buffer) {
+        for (sf::Sound& voice : voices) {
+            voice.setBuffer(buffer);
+        }
+    }
+
+    // 物理步后调用：记录本步的碰撞事件
+    void collect(const PhysicsEventStream& events) {
+        if (events.count(PhysicsEventType::Contact) == 0) return;
+        for (const PhysicsEvent& event : events) {
+            if (event.type == PhysicsEventType::Contact) {
+                pending.push_back(event);
+            }
+        }
+    }
+
+    // 每帧调用一次：合并本帧收集的事件并播放
+    void playFrame(float elapsed) {
+        clock += elapsed;
+
+        // 冷却已过的球对不再需要记录，表中只剩最近发过声的少数几对
+        if (!pairLastPlayed.empty()) {
+            std::erase_if(pairLastPlayed, [this](const auto& entry) {
+                return clock - entry.second >= COLLISION_PAIR_COOLDOWN;
+            });
+        }
+        if (pending.empty()) return;
+
+        // 同一对球只保留最强的一次
+        std::sort(pending.begin(), pending.end(), [](const PhysicsEvent& x, const PhysicsEvent& y) {
+            if (pairKey(x) != pairKey(y)) return pairKey(x) < pairKey(y);
+            return x.value > y.value;
+        });
+        pending.erase(std::unique(pending.begin(), pending.end(),
+                                  [](const PhysicsEvent& x, const PhysicsEvent& y) {
+                                      return pairKey(x) == pairKey(y);
+                                  }),
+                      pending.end());
+
+        // 先播放最响的
+        std::sort(pending.begin(), pending.end(), [](const PhysicsEvent& x, const PhysicsEvent& y) {
+            return x.value > y.value;
+        });
+
+        std::size_t played = 0;
+        for (const PhysicsEvent& event : pending) {
+            if (played == COLLISION_PLAYS_PER_FRAME || event.value < COLLISION_MIN_SPEED) break;
+
+            // 表中还在的球对都处于冷却中
+            if (!pairLastPlayed.emplace(pairKey(event), clock).second) continue;
+
+            const float loudness = std::min(event.value / COLLISION_FULL_SPEED, 1.f);
+            playVoice(loudness * 100.f);
+            played++;
+        }
+        pending.clear();
+    }
+
+private:
+    std::array<sf::Sound, COLLISION_VOICES> voices;         // 固定的声部
+    std::array<float, COLLISION_VOICES> voiceStarted{};     // 各声部开始播放的时刻
+    std::vector<PhysicsEvent> pending;                      // 本帧收集的碰撞事件（value 为接近速度）
+    std::unordered_map<std::uint64_t, float> pairLastPlayed;  // 冷却中的球对 -> 上次发声的时刻
+    float clock = 0.f;                                      // 累计时间（秒）
+
+    // 与两球的先后顺序无关的球对编号
+    static std::uint64_t pairKey(const PhysicsEvent& event) {
+        return (static_cast<std::uint64_t>(std::min(event.a, event.b)) << 32) | std::max(event.a, event.b);
+    }
+
+    // 使用空闲声部播放，没有空闲声部时抢占最早开始的
+    void playVoice(float volume) {
+        std::size_t chosen = 0;
+        for (std::size_t i = 0; i < voices.size(); ++i) {
+            if (voices[i].getStatus() != sf::Sound::Playing) {
+                chosen = i;
+                break;
+            }
+            if (voiceStarted[i] < voiceStarted[chosen]) chosen = i;
+        }
+        voices[chosen].setVolume(volume);
+        voices[chosen].play();
+        voiceStarted[chosen] = clock;
+    }
+};
@@ -10,277 +10,76 @@
 #include <string>
 #include <iostream>
 #include <cstring>
-#include <functional>
-
-// 窗口相关常量
-constexpr int WINDOW_WIDTH = 1920;      // 游戏窗口宽度（像素）
-constexpr int WINDOW_HEIGHT = 1080;     // 游戏窗口高度（像素）
-
-// 游戏对象尺寸常量
-constexpr float PLAYER_RADIUS = 25.f;   // 玩家球体半径
-constexpr float ENEMY_RADIUS = 25.f;    // 敌方球体半径
-
-// 物理相关常量
-constexpr float REBOUND_COEFFICIENT = 0.8f;    // 碰撞后的反弹系数（0-1之间，1为完全弹性碰撞）
-constexpr float FRICTION_COEFFICIENT = 0.98f;   // 地面摩擦系数（每帧速度衰减比例）
+#include <future>
+#include <map>
+#include <memory>
+#include <random>
+#include <cstdlib>
+#include <thread>
+#include "Physics.h"
+#include "SimulationClock.h"
+#include "SpriteBatch.h"
+#include "HudText.h"
+#include "CollisionAudio.h"
+#include "SaveFile.h"
+#include "Replay.h"
+#include "Rollback.h"
+#include "ShotPlanner.h"
+#include "AssetLoader.h"
+#include "TextureManager.h"
+#include "Scene.h"
 
 // 中心区域（目标区域）相关常量
-const sf::Vector2f CENTER_ZONE_POSITION(710, 290);  // 中心区域左上角坐标
-const sf::Vector2f CENTER_ZONE_SIZE(500, 500);      // 中心区域的宽度和高度
-
-// 游戏机制相关常量
-constexpr int NUM_ENEMIES = 6;              // 场上敌方球体的数量
-constexpr float CHARGE_MAX_TIME = 4.f;      // 最大蓄力时间（秒）
+const sf::Vector2f CENTER_ZONE_POSITION(CENTER_ZONE_X, CENTER_ZONE_Y);        // 中心区域左上角坐标
+const sf::Vector2f CENTER_ZONE_SIZE(CENTER_ZONE_WIDTH, CENTER_ZONE_HEIGHT);   // 中心区域的宽度和高度
 
 // Add this with other constants at the top
 constexpr const char* FINAL_SAVE_FILE = "final_save.bin";
+constexpr const char* FINAL_REPLAY_FILE = "final_replay.bin";  // 本局的整局回放（种子和击球输入）
 
-// 纹理管理器类：负责加载和管理所有游戏纹理
-class TextureManager {
-public:
-    sf::Texture& getTexture(const std::string& filename) {
-        auto& texture = textures[filename];
-        if (!texture.loadFromFile(filename)) {
-            std::cerr << "Error loading texture from " << filename << std::endl;
-            throw std::runtime_error("Failed to load texture!");
-        }
-        return texture;
-    }
+// 回放控制
+constexpr float REPLAY_SEEK_SECONDS = 5.f;      // 左右方向键每次跳转的时长
+constexpr float REPLAY_MIN_SPEED = 0.25f;       // 最慢播放速度
+constexpr float REPLAY_MAX_SPEED = 64.f;        // 最快播放速度
 
-private:
-    // 存储容器
-    std::map<std::string, sf::Texture> textures;  // 纹理映射表
-};
+// 小鸟贴图（打包在同一张图集中）
+constexpr const char* ENEMY_TEXTURE_FILE = "Images/bird_2.png";
+constexpr const char* PLAYER_TEXTURE_FILE = "Images/bird_1.png";
 
-// 游戏对象基类：所有可移动物体的基类
+// 游戏场景的其他资源
+constexpr const char* BACKGROUND_FILE = "Images/background.png";
+constexpr const char* BACKGROUND_END_FILE = "Images/backgroundend.png";
+constexpr const char* COLLISION_SOUND_FILE = "collision.flac";
+
+// 游戏对象：物理状态保存在 PhysicsWorld 中，这里只负责渲染
 class GameObject {
 public:
-    // 视觉组件
-    sf::Sprite sprite;                   // 精灵对象，用于渲染
-    
-    // 物理属性
-    sf::Vector2f velocity;              // 速度向量
-    float mass;                         // 质量
-    bool isStopped;                     // 停止状态标志
-
-    // 旋转相关属性
-    float angularVelocity;              // 角速度
-    float rotationDamping;              // 旋转阻尼系数
-
-    // 特殊球属性
-    bool isSpecial;                     // 是否为特殊球
-    bool hasTriggeredSpecial;           // 是否已触发特殊效果
-    bool hasBeenLaunched;               // 是否已被发射
-
-    // 特殊效果回调函数
-    std::function<void(GameObject&)> onSpecialEffect;
-
-    // 构造函数：初始化游戏对象
-    GameObject(float radius, const std::string& textureFile, sf::Vector2f position, 
-              TextureManager& textureManager, float m = 1.0f)
-            : velocity(0.f, 0.f), mass(m), isStopped(true), 
-              angularVelocity(0.f), rotationDamping(0.98f),
-              isSpecial(false), hasTriggeredSpecial(false),
-              hasBeenLaunched(false) {
-        sprite.setTexture(textureManager.getTexture(textureFile));
-        
-        // 确保将原点设置在纹理的中心
-        sf::Vector2u textureSize = sprite.getTexture()->getSize();
-        sprite.setOrigin(textureSize.x / 2.f, textureSize.y / 2.f);
-        
-        // 设置位置和缩放
-        sprite.setPosition(position);
-        float scaleX = (radius * 2) / static_cast<float>(textureSize.x);
-        float scaleY = (radius * 2) / static_cast<float>(textureSize.y);
-        sprite.setScale(scaleX, scaleY);
-    }
-
-    // 渲染方法
-    void draw(sf::RenderWindow& window) const {
-        window.draw(sprite);
-    }
+    // 构造函数：region 为贴图在图集中的区域，按半径缩放
+    GameObject(float radius, const sf::FloatRect& region)
+            : region(region), size(radius * 2, radius * 2) {}
 
-    // 更新物体位置和状态
-    void updatePosition(float dt) {
-        if (!isStopped) {
-            hasBeenLaunched = true;
-            sprite.move(velocity * dt);
-            velocity *= FRICTION_COEFFICIENT;
+    // 从物理状态同步位置和旋转，alpha 为上一步到当前步之间的插值系数
+    void sync(const BodyStore& bodies, size_t index, float alpha) {
+        position.x = bodies.prevX[index] + (bodies.x[index] - bodies.prevX[index]) * alpha;
+        position.y = bodies.prevY[index] + (bodies.y[index] - bodies.prevY[index]) * alpha;
 
-            // 更新旋转
-            float speed = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
-            angularVelocity = -speed * 0.5f;
-            sprite.rotate(angularVelocity * dt);
-            
-            // 检查停止条件
-            if (std::abs(velocity.x) < 0.01f && std::abs(velocity.y) < 0.01f) {
-                isStopped = true;
-                velocity = {0.f, 0.f};
-                angularVelocity = 0.f;
-
-                // 触发特殊效果（如果是特殊球）
-                if (isSpecial && hasBeenLaunched && !hasTriggeredSpecial && onSpecialEffect) {
-                    onSpecialEffect(*this);
-                    hasTriggeredSpecial = true;
-                }
-            }
-        }
+        // 旋转沿较短的方向插值
+        float delta = bodies.rotation[index] - bodies.prevRotation[index];
+        if (delta > 180.f) delta -= 360.f;
+        if (delta < -180.f) delta += 360.f;
+        rotation = bodies.prevRotation[index] + delta * alpha;
     }
 
-    // 边界碰撞检测和处理
-    void applyBoundaryCollision() {
-        auto bounds = sprite.getGlobalBounds();
-
-        // 检测左右边界碰撞
-        if (bounds.left < 280 || bounds.left + bounds.width > WINDOW_WIDTH - 300) {
-            velocity.x = -velocity.x * REBOUND_COEFFICIENT;
-            sprite.setPosition(
-                std::max(bounds.width / 2, 
-                std::min(sprite.getPosition().x, WINDOW_WIDTH - bounds.width / 2)), 
-                sprite.getPosition().y
-            );
-        }
-
-        // 检测上下边界碰撞
-        if (bounds.top < 120 || bounds.top + bounds.height > WINDOW_HEIGHT) {
-            velocity.y = -velocity.y * REBOUND_COEFFICIENT;
-            sprite.setPosition(
-                sprite.getPosition().x, 
-                std::max(bounds.height / 2, 
-                std::min(sprite.getPosition().y, WINDOW_HEIGHT - bounds.height / 2))
-            );
-        }
-    }
-
-    // 保存对象状态
-    void save(std::ofstream& file) const {
-        std::vector<char> buffer(sizeof(float) * 6 + sizeof(bool) * 4);
-        char* ptr = buffer.data();
-
-        sf::Vector2f pos = sprite.getPosition();
-        float rotation = sprite.getRotation();
-
-        // 保存位置、速度和旋转信息
-        std::memcpy(ptr, &pos.x, sizeof(float));
-        ptr += sizeof(float);
-        std::memcpy(ptr, &pos.y, sizeof(float));
-        ptr += sizeof(float);
-        std::memcpy(ptr, &velocity.x, sizeof(float));
-        ptr += sizeof(float);
-        std::memcpy(ptr, &velocity.y, sizeof(float));
-        ptr += sizeof(float);
-        std::memcpy(ptr, &angularVelocity, sizeof(float));
-        ptr += sizeof(float);
-        std::memcpy(ptr, &rotation, sizeof(float));
-        ptr += sizeof(float);
-
-        // 保存状态标志
-        std::memcpy(ptr, &isStopped, sizeof(bool));
-        ptr += sizeof(bool);
-        std::memcpy(ptr, &isSpecial, sizeof(bool));
-        ptr += sizeof(bool);
-        std::memcpy(ptr, &hasTriggeredSpecial, sizeof(bool));
-        ptr += sizeof(bool);
-        std::memcpy(ptr, &hasBeenLaunched, sizeof(bool));
-
-        file.write(buffer.data(), buffer.size());
-    }
-
-    // 加载对象状态
-    void load(std::ifstream& file) {
-        std::vector<char> buffer(sizeof(float) * 6 + sizeof(bool) * 4);
-        file.read(buffer.data(), buffer.size());
-        char* ptr = buffer.data();
-
-        sf::Vector2f pos;
-        float rotation;
-
-        // 加载位置、速度和旋转信息
-        std::memcpy(&pos.x, ptr, sizeof(float));
-        ptr += sizeof(float);
-        std::memcpy(&pos.y, ptr, sizeof(float));
-        ptr += sizeof(float);
-        sprite.setPosition(pos);
-
-        std::memcpy(&velocity.x, ptr, sizeof(float));
-        ptr += sizeof(float);
-        std::memcpy(&velocity.y, ptr, sizeof(float));
-        ptr += sizeof(float);
-        std::memcpy(&angularVelocity, ptr, sizeof(float));
-        ptr += sizeof(float);
-        std::memcpy(&rotation, ptr, sizeof(float));
-        ptr += sizeof(float);
-        sprite.setRotation(rotation);
-        
-        // 加载状态标志
-        std::memcpy(&isStopped, ptr, sizeof(bool));
-        ptr += sizeof(bool);
-        std::memcpy(&isSpecial, ptr, sizeof(bool));
-        ptr += sizeof(bool);
-        std::memcpy(&hasTriggeredSpecial, ptr, sizeof(bool));
-        ptr += sizeof(bool);
-        std::memcpy(&hasBeenLaunched, ptr, sizeof(bool));
+    // 渲染方法：加入本帧的批处理，由批处理统一绘制
+    void draw(SpriteBatch& batch) const {
+        batch.addSprite(region, position, size, rotation);
     }
-};
-
-// 碰撞处理器：处理游戏对象之间的碰撞
-class CollisionHandler {
-public:
-    static void applyCollision(GameObject& a, GameObject& b, sf::Sound& collisionSound) {
-        // 获取两个球的圆心位置
-        sf::Vector2f posA = a.sprite.getPosition();
-        sf::Vector2f posB = b.sprite.getPosition();
-
-        // 计算两球中心之间的距离
-        sf::Vector2f delta = posA - posB;
-        float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
-        
-        // 获取两球的半径
-        float radiusA = a.sprite.getGlobalBounds().width / 2;
-        float radiusB = b.sprite.getGlobalBounds().width / 2;
 
-        // 检查是否发生碰撞（两球中心距离是否小于半径之和）
-        if (distance < radiusA + radiusB) {
-            collisionSound.play();  // 播放碰撞音效
-
-            // 计算碰撞法线（单位向量）
-            sf::Vector2f normal = delta / distance;
-
-            // 计算相对速度
-            auto relativeVelocity = a.velocity - b.velocity;
-            float velocityAlongNormal = relativeVelocity.x * normal.x + relativeVelocity.y * normal.y;
-
-            // 如果物体正在分离，则不处理碰撞
-            if (velocityAlongNormal > 0) return;
-
-            // 更新速度（基于动量守恒和能量守恒）
-            sf::Vector2f temp = a.velocity;
-            a.velocity = 0.5f * (a.velocity + b.velocity + REBOUND_COEFFICIENT * (b.velocity - a.velocity));
-            b.velocity = 0.5f * (b.velocity + temp + REBOUND_COEFFICIENT * (temp - b.velocity));
-
-            // 计算碰撞后的速度大小
-            float speedA = std::sqrt(a.velocity.x * a.velocity.x + a.velocity.y * a.velocity.y);
-            float speedB = std::sqrt(b.velocity.x * b.velocity.x + b.velocity.y * b.velocity.y);
-            
-            // 根据碰撞点的相对位置决定旋转方向
-            float crossProduct = normal.x * relativeVelocity.y - normal.y * relativeVelocity.x;
-            float rotationFactor = 0.5f;
-            
-            // 更新角速度
-            a.angularVelocity = -speedA * rotationFactor * (crossProduct > 0 ? 1 : -1);
-            b.angularVelocity = -speedB * rotationFactor * (crossProduct > 0 ? -1 : 1);
-
-            // 防止球体重叠
-            float overlap = (radiusA + radiusB - distance) / 2.0f;
-            sf::Vector2f separation = normal * overlap;
-            a.sprite.setPosition(posA + separation);
-            b.sprite.setPosition(posB - separation);
-
-            // 设置运动状态
-            a.isStopped = false;
-            b.isStopped = false;
-        }
-    }
+private:
+    sf::FloatRect region;               // 贴图在图集中的区域
+    sf::Vector2f size;                  // 绘制大小（直径）
+    sf::Vector2f position;              // 插值后的中心位置
+    float rotation = 0.f;               // 插值后的旋转角度
 };
 
 // 分数管理器：处理游戏分数的记录和保存
@@ -340,38 +139,52 @@ private:
 enum GameState {
     Playing,                            // 游戏进行中
     EndScreen,                          // 结束画面
-    ArchiveView                         // 存档查看
+    ArchiveView,                        // 存档查看
+    ReplayView                          // 整局回放
 };
 
-// 游戏主类：管理整个游戏的运行
-class Game {
+// 游戏场景：管理一局游戏的运行（窗口、纹理缓存和字体由 Application 提供）
+class Game : public Scene {
 private:
-    // 窗口和图形相关
-    sf::RenderWindow window;            // 游戏窗口
-    sf::Image icon;                     // 窗口图标
-    sf::Font font;                      // 游戏字体
-    TextureManager textureManager;      // 纹理管理器
+    // 资源加载
+    AssetLoader& assets;                // 后台资源加载（菜单停留期间已开始预取）
+
+    // 窗口和图形相关（与菜单共享）
+    sf::RenderWindow& window;           // 游戏窗口
+    const sf::Font& font;               // 游戏字体
+    TextureManager& textureManager;     // 纹理管理器
+    const TextureAtlas& birdAtlas;      // 小鸟和纯色 UI 共用的图集
+    SpriteBatch spriteBatch;            // 每帧一次绘制所有小鸟、边框和蓄力条
 
     // 背景相关
-    sf::Texture backgroundTexture;      // 游戏背景纹理
+    TextureRef backgroundTexture;       // 游戏背景纹理
     sf::Sprite backgroundSprite;        // 游戏背景精灵
-    sf::Texture backgroundTextureEnd;   // 结束画面背景纹理
+    TextureRef backgroundTextureEnd;    // 结束画面背景纹理
     sf::Sprite backgroundSpriteEnd;     // 结束画面背景精灵
 
     // 音频相关
     sf::Music backgroundMusic;          // 背景音乐
     sf::SoundBuffer collisionBuffer;    // 碰撞音效缓冲
-    sf::Sound collisionSound;          // 碰撞音效
+    CollisionAudio collisionAudio;      // 碰撞音效（固定声部，每帧合并碰撞事件）
 
     // 游戏对象
-    std::vector<GameObject> enemies;    // 敌方球体
-    std::vector<GameObject> players;    // 玩家球体
+    PhysicsWorld world;                     // 物理世界（所有球体的物理状态）
+    std::vector<GameObject> enemySprites;   // 敌方球体的渲染对象
+    std::vector<GameObject> playerSprites;  // 玩家球体的渲染对象
 
     // UI元素
-    sf::Text scoreText;                // 分数显示
-    sf::Text highScoreText;            // 最高分显示
-    sf::Text playerCountText;          // 玩家数量显示
+    HudText scoreText;                 // 分数显示
+    HudText highScoreText;             // 最高分显示
+    HudText playerCountText;           // 玩家数量显示
     sf::Text selectionText;            // 选择提示文本
+
+    // 结束画面文本（只在数值变化时重新排版）
+    HudText endHighScoreText;          // 历史记录
+    HudText endCurrentScoreText;       // 本局分数
+    HudText archiveHintText;           // 查看存档提示
+    HudText replayText;                // 回放进度和操作提示
+    HudText rollbackText;              // 存档查看模式下的撤销/重试提示
+    HudText hintText;                  // 击球提示
     sf::RectangleShape centerZoneBorder; // 中心区域边界
     sf::RectangleShape chargeBar;      // 蓄力条
 
@@ -392,40 +205,62 @@ private:
     bool isCharging;                   // 蓄力状态标志
     float chargeTime;                  // 当前蓄力时间
 
+    // 可复现
+    std::uint64_t roundSeed;           // 本局种子（决定敌方布局）
+
+    // 回放
+    ReplayLog replayLog;                        // 本局的击球记录
+    bool recordingReplay;                       // 读档后局面与种子不再对应，停止记录
+    std::uint32_t playedSteps;                  // 本局已模拟的步数（击球记录的时间轴）
+    std::unique_ptr<ReplayPlayer> replayPlayer; // 回放时的播放器
+
+    // 存档查看模式下的回退
+    RollbackBuffer rollback;                    // 定时和击球前的世界快照
+    std::uint32_t archiveSteps;                 // 进入存档查看后已模拟的步数
+
+    // 击球提示：在后台线程上规划，不占用渲染线程（hintRequest 最先销毁，等规划结束后才销毁其余成员）
+    JobSystem hintJobs;                         // 规划用的任务系统（给渲染线程留出一个核心）
+    ShotPlanner hintPlanner;                    // 击球规划器
+    ShotPlan hint;                              // 当前显示的提示（found 为 false 时不显示）
+    int hintShots;                              // 发出请求时的已发射次数；之后局面变了（击球、读档）置为 -1，结果作废
+    std::future<ShotPlan> hintRequest;          // 正在进行的规划
+
+    // 时间管理
+    SimulationClock simulationClock;   // 固定步长模拟时钟
+
 public:
-    // 构造函数：初始化游戏
-    Game() : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), L"哐哐当当雀雀球"),
+    // 构造函数：初始化游戏，使用共享的窗口和资源，图片和音效通过 assets 在后台解码
+    explicit Game(const SceneContext& context)
+           : assets(context.assets),
+             window(context.window),
+             font(context.font),
+             textureManager(context.textures),
+             birdAtlas(textureManager.getAtlas({ENEMY_TEXTURE_FILE, PLAYER_TEXTURE_FILE})),
+             spriteBatch(birdAtlas),
              scoreManager("highscores.txt"),
              normalCount(2), specialCount(2), isCharging(false), chargeTime(0.f),
              selectedPlayerIndex(0), hadshoot(0), viewArchiveMode(false), 
-             currentGameState(Playing), archiveShootCount(0) {
+             currentGameState(Playing), archiveShootCount(0), roundSeed(chooseSeed()),
+             recordingReplay(true), playedSteps(0), archiveSteps(0),
+             hintJobs(std::max(2u, std::thread::hardware_concurrency()) - 1), hintPlanner(&hintJobs), hintShots(0) {
         
-        // 设置窗口属性
-        window.setFramerateLimit(60);
-
-        // 加载窗口图标
-        if (icon.loadFromFile("Images/bird_2.png")) {
-            window.setIcon(icon.getSize().x, icon.getSize().y, icon.getPixelsPtr());
-        }
+        // 没有经过菜单预取的资源在这里开始后台解码，与音乐的加载重叠
+        prefetchAssets(assets);
 
         // 加载背景图片
-        if (!backgroundTexture.loadFromFile("Images/background.png")) {
+        try {
+            backgroundTexture = textureManager.acquire(BACKGROUND_FILE);
+            backgroundSprite.setTexture(backgroundTexture.get());
+        } catch (const std::runtime_error&) {
             std::cerr << "Error: Failed to load background image!" << std::endl;
-        } else {
-            backgroundSprite.setTexture(backgroundTexture);
         }
 
         // 加载结束画面背景
-        if (!backgroundTextureEnd.loadFromFile("Images/backgroundend.png")) {
+        try {
+            backgroundTextureEnd = textureManager.acquire(BACKGROUND_END_FILE);
+            backgroundSpriteEnd.setTexture(backgroundTextureEnd.get());
+        } catch (const std::runtime_error&) {
             std::cerr << "Error: Failed to load end screen background!" << std::endl;
-        } else {
-            backgroundSpriteEnd.setTexture(backgroundTextureEnd);
-        }
-
-        // 加载字体
-        if (!font.loadFromFile("chinese.ttf")) {
-            std::cerr << "Error: Could not load font file: chinese.ttf" << std::endl;
-            return;
         }
 
         // 加载并设置背景音乐
@@ -438,11 +273,24 @@ public:
         }
 
         // 初始化UI文本
-        initializeText(scoreText, 30, sf::Vector2f(WINDOW_WIDTH - 600, 140));
-        initializeText(highScoreText, 30, sf::Vector2f(WINDOW_WIDTH - 600, 185));
-        initializeText(playerCountText, 30, sf::Vector2f(WINDOW_WIDTH - 550, WINDOW_HEIGHT - 220));
+        scoreText.setup(font, 30, sf::Vector2f(WINDOW_WIDTH - 600, 140));
+        highScoreText.setup(font, 30, sf::Vector2f(WINDOW_WIDTH - 600, 185));
+        playerCountText.setup(font, 30, sf::Vector2f(WINDOW_WIDTH - 550, WINDOW_HEIGHT - 220));
         initializeText(selectionText, 24, sf::Vector2f(WINDOW_WIDTH / 2 - 100, WINDOW_HEIGHT - 150));
 
+        // 结束画面文本：分数居中，提示水平居中
+        endHighScoreText.setup(font, 70, sf::Vector2f(WINDOW_WIDTH / 2, WINDOW_HEIGHT / 2 + 40), sf::Vector2f(0.5f, 0.5f));
+        endCurrentScoreText.setup(font, 70, sf::Vector2f(WINDOW_WIDTH / 2, WINDOW_HEIGHT / 2 - 100), sf::Vector2f(0.5f, 0.5f));
+        archiveHintText.setup(font, 40, sf::Vector2f(WINDOW_WIDTH / 2, WINDOW_HEIGHT - 200), sf::Vector2f(0.5f, 0.f));
+        archiveHintText.set(L"按 V 键查看存档，再次按 V 返回；按 P 键观看整局回放");
+        replayText.setup(font, 30, sf::Vector2f(WINDOW_WIDTH / 2, 40), sf::Vector2f(0.5f, 0.f));
+        rollbackText.setup(font, 30, sf::Vector2f(WINDOW_WIDTH / 2, 40), sf::Vector2f(0.5f, 0.f));
+        hintText.setup(font, 30, sf::Vector2f(WINDOW_WIDTH / 2, 40), sf::Vector2f(0.5f, 0.f));
+
+        // 预先生成 HUD 会用到的字形，避免分数第一次变化时卡顿
+        HudText::warmUpGlyphs(font, L"0123456789-本局分数历史记录剩余次额外击球：按键查看存档，再返回；观看整回放秒倍暂停空格跳转变速/×←→↑↓撤销重试倒退此位置最佳无提示第只鸟蓄力秒预计得没有可用的规划中.… ",
+                              {24, 30, 40, 70});
+
         // 设置中心区域边界
         centerZoneBorder.setSize(CENTER_ZONE_SIZE);
         centerZoneBorder.setOutlineThickness(30);
@@ -456,82 +304,125 @@ public:
         chargeBar.setPosition(WINDOW_WIDTH - 180, WINDOW_HEIGHT - 620);
 
         // 加载碰撞音效
-        collisionBuffer.loadFromFile("collision.flac");
-        collisionSound.setBuffer(collisionBuffer);
+        assets.uploadSound(COLLISION_SOUND_FILE, collisionBuffer);
+        collisionAudio.setBuffer(collisionBuffer);
+
+        assets.release(COLLISION_SOUND_FILE);
 
         // 初始化游戏对象
+        std::cout << "本局种子: " << roundSeed << std::endl;
+        replayLog.seed = roundSeed;
         initializeEnemies();
         initializePlayers();
     }
 
-    // 游戏主循环
-    void run() {
-        while (window.isOpen()) {
-            handleEvents();
-            bool hasSpecialBallPending = false;
-
-            switch (currentGameState) {
-                case Playing:
-                    if (isCharging) updateCharge();
-                    updateGameObjects();
-                    checkCollisions();
-                    updateEnemyCount();
-                    updateMessage();
-                    
-                    // 首先检查所有球是否停止
-                    allPlayersStopped = std::all_of(players.begin(), players.end(), 
-                        [](const GameObject& player) { return player.isStopped; });
-
-                    // 检查是否有特殊球需要触发效果
-                    if (allPlayersStopped && hadshoot >= players.size()) {
-                        for (const auto& player : players) {
-                            if (player.isSpecial && player.hasBeenLaunched && !player.hasTriggeredSpecial) {
-                                hasSpecialBallPending = true;
-                                break;
-                            }
-                        }
-                    }
+    // 处理一个输入事件
+    void handleEvent(const sf::Event& event) override {
+        if (currentGameState == Playing) {  // 正常游戏模式
+            handlePlayingStateEvents(event);
+        }
+        else if (currentGameState == ArchiveView) {  // 存档查看模式
+            handleArchiveViewEvents(event);
+        }
+        else if (currentGameState == EndScreen) {  // 结束画面：P 键开始回放
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::P) {
+                startReplay();
+            }
+        }
+        else if (currentGameState == ReplayView) {  // 回放模式
+            handleReplayEvents(event);
+        }
 
-                    // 只有在以下条件全部满足时才结束游戏：
-                    // 1. 所有球都已发射
-                    // 2. 所有球都已停止
-                    // 3. 没有待触发的特殊效果
-                    // 4. 所有特殊球的效果都已触发完成
-                    if (hadshoot >= players.size() && allPlayersStopped && !hasSpecialBallPending) {
-                        bool allEffectsCompleted = std::all_of(players.begin(), players.end(),
-                            [](const GameObject& player) {
-                                return !player.isSpecial || !player.hasBeenLaunched || player.hasTriggeredSpecial;
-                            });
-                        
-                        // 检查所有球（包括敌人）是否都已停止
-                        bool allBallsStopped = std::all_of(enemies.begin(), enemies.end(),
-                            [](const GameObject& enemy) { return enemy.isStopped; });
-                        
-                        if (allEffectsCompleted && allBallsStopped) {
-                            saveGame(FINAL_SAVE_FILE);  
-                            currentGameState = EndScreen;
-                        }
+        // V键切换游戏状态
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::V) {
+            handleStateTransition();
+        }
+    }
+
+    // 推进一帧
+    void update(float elapsed) override {
+        bool hasSpecialBallPending = false;
+
+        switch (currentGameState) {
+            case Playing:
+                if (isCharging) updateCharge(elapsed);
+                stepSimulation(elapsed);
+                updateEnemyCount();
+                updateMessage();
+                pollHint();
+
+                // 首先检查所有球是否停止
+                allPlayersStopped = world.playersStopped();
+
+                // 检查是否有特殊球需要触发效果
+                if (allPlayersStopped && hadshoot >= world.playerCount()) {
+                    hasSpecialBallPending = world.hasPendingSpecial();
+                }
+
+                // 只有在以下条件全部满足时才结束游戏：
+                // 1. 所有球都已发射
+                // 2. 所有球都已停止
+                // 3. 没有待触发的特殊效果
+                // 4. 所有特殊球的效果都已触发完成
+                if (hadshoot >= world.playerCount() && allPlayersStopped && !hasSpecialBallPending) {
+                    bool allEffectsCompleted = !world.hasPendingSpecial();
+
+                    // 检查所有球（包括敌人）是否都已停止
+                    bool allBallsStopped = world.enemiesStopped();
+
+                    if (allEffectsCompleted && allBallsStopped) {
+                        std::cout << "本局结束: 种子 " << roundSeed << "，状态哈希 " << std::hex
+                                  << world.stateHash() << std::dec << std::endl;
+                        saveGame(FINAL_SAVE_FILE);
+                        saveReplay(FINAL_REPLAY_FILE);
+                        currentGameState = EndScreen;
                     }
-                    render();
-                    break;
-
-                case EndScreen:
-                    renderEndScene();
-                    break;
-
-                case ArchiveView:
-                    if (isCharging) updateCharge();
-                    updateGameObjects();
-                    checkCollisions();
-                    updateEnemyCount();
-                    updateMessage();
-                    render();
-                    break;
-            }
+                }
+                break;
+
+            case EndScreen:
+                simulationClock.reset();
+                break;
+
+            case ArchiveView:
+                if (isCharging) updateCharge(elapsed);
+                stepSimulation(elapsed);
+                updateEnemyCount();
+                updateMessage();
+                break;
+
+            case ReplayView:
+                // 回放不改动分数记录，只显示当时的分数
+                replayPlayer->update(elapsed, [this] { collisionAudio.collect(world.events); });
+                collisionAudio.playFrame(elapsed);
+                scoreText.set(L"本局分数： ", world.countEnemiesOutsideZone());
+                updateReplayText();
+                break;
+        }
+    }
+
+    // 绘制当前状态的画面
+    void render() override {
+        if (currentGameState == EndScreen) {
+            renderEndScene();
+        } else {
+            renderPlayScene();
         }
+    }
+
+    // 离开游戏时保存最高分
+    void onExit() override {
         scoreManager.saveScore();
     }
 
+    // 在后台预先解码游戏场景用到的图片和音效（菜单停留期间即可调用）
+    static void prefetchAssets(AssetLoader& assets) {
+        for (const char* file : {BACKGROUND_FILE, BACKGROUND_END_FILE, ENEMY_TEXTURE_FILE, PLAYER_TEXTURE_FILE}) {
+            assets.prefetchImage(file);
+        }
+        assets.prefetchSound(COLLISION_SOUND_FILE);
+    }
+
 private:
     // 初始化文本对象
     void initializeText(sf::Text &text, int size, sf::Vector2f position) {
@@ -541,130 +432,35 @@ private:
         text.setFillColor(sf::Color::White);
     }
 
-    // 初始化敌方球体
+    // 初始化敌方球体：布局完全由本局种子决定
     void initializeEnemies() {
-        for (int i = 0; i < NUM_ENEMIES; ++i) {
-            sf::Vector2f position;
-            bool validPosition = false;
-
-            // 寻找有效的初始位置
-            while (!validPosition) {
-                float x = CENTER_ZONE_POSITION.x + std::rand() % static_cast<int>(CENTER_ZONE_SIZE.x);
-                float y = CENTER_ZONE_POSITION.y + std::rand() % static_cast<int>(CENTER_ZONE_SIZE.y);
-                position = sf::Vector2f(x, y);
-                validPosition = true;
-
-                // 检查是否在中心区域内
-                if (position.x - ENEMY_RADIUS < CENTER_ZONE_POSITION.x ||
-                    position.x + ENEMY_RADIUS > CENTER_ZONE_POSITION.x + CENTER_ZONE_SIZE.x ||
-                    position.y - ENEMY_RADIUS < CENTER_ZONE_POSITION.y ||
-                    position.y + ENEMY_RADIUS > CENTER_ZONE_POSITION.y + CENTER_ZONE_SIZE.y) {
-                    validPosition = false;
-                    continue;
-                }
+        world.spawnEnemies(roundSeed);
+        for (size_t i = 0; i < world.enemyCount(); ++i) {
+            enemySprites.emplace_back(ENEMY_RADIUS, birdAtlas.getRegion(ENEMY_TEXTURE_FILE));
+        }
+    }
 
-                // 检查与其他敌方球体的距离
-                for (const auto &enemy: enemies) {
-                    float dist = std::sqrt(std::pow(position.x - enemy.sprite.getPosition().x, 2) +
-                                       std::pow(position.y - enemy.sprite.getPosition().y, 2));
-                    if (dist < ENEMY_RADIUS + ENEMY_RADIUS + 50) {
-                        validPosition = false;
-                        break;
-                    }
-                }
-            }
-            enemies.emplace_back(ENEMY_RADIUS, "Images/bird_2.png", position, textureManager);
+    // 本局种子：设置了环境变量 BIRDS_SEED 时使用它（复现玩家报告的对局），否则随机选取
+    static std::uint64_t chooseSeed() {
+        if (const char* env = std::getenv("BIRDS_SEED")) {
+            return std::strtoull(env, nullptr, 10);
         }
+        std::random_device device;
+        return (static_cast<std::uint64_t>(device()) << 32) | device();
     }
 
     // 初始化玩家球体
     void initializePlayers() {
         selectedPlayerIndex = 0;
-        players = {
-            GameObject(PLAYER_RADIUS, "Images/bird_1.png",
-                      sf::Vector2f(WINDOW_WIDTH / 2 - 170, WINDOW_HEIGHT - 170), textureManager),
-            GameObject(PLAYER_RADIUS, "Images/bird_1.png", 
-                      sf::Vector2f(WINDOW_WIDTH / 2 - 70, WINDOW_HEIGHT - 170), textureManager),
-            GameObject(PLAYER_RADIUS, "Images/bird_1.png", 
-                      sf::Vector2f(WINDOW_WIDTH / 2 + 30, WINDOW_HEIGHT - 170), textureManager, 1.0f),
-            GameObject(PLAYER_RADIUS, "Images/bird_1.png",
-                      sf::Vector2f(WINDOW_WIDTH / 2 + 130, WINDOW_HEIGHT - 170), textureManager, 1.0f)
-        };
-        
-        // 设置第3和第4个球为特殊球，并设置它们的特殊效果回调
-        players[2].isSpecial = true;
-        players[3].isSpecial = true;
-        
-        // 为特殊球设置回调函数
-        auto specialEffect = [this](GameObject& ball) {
-            this->triggerSpecialEffect(ball);
-        };
-        
-        players[2].onSpecialEffect = specialEffect;
-        players[3].onSpecialEffect = specialEffect;
-
-        // 确保所有球的初始状态正确
-        for (auto& player : players) {
-            player.isStopped = true;
-            player.hasBeenLaunched = false;
-            player.hasTriggeredSpecial = false;
-            player.velocity = sf::Vector2f(0.f, 0.f);
-            player.angularVelocity = 0.f;
-        }
-    }
-
-    // 特殊效果触发函数
-    void triggerSpecialEffect(GameObject& specialBall) {
-        const float EFFECT_RADIUS = 150.f;
-        const float PUSH_FORCE = 100.f;
-
-        // 对敌方球施加效果
-        for (auto& enemy : enemies) {
-            sf::Vector2f delta = enemy.sprite.getPosition() - specialBall.sprite.getPosition();
-            float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
-
-            if (distance < EFFECT_RADIUS && distance > 0) {
-                sf::Vector2f direction = delta / distance;
-                float forceMagnitude = PUSH_FORCE * (1.0f - distance / EFFECT_RADIUS);
-                enemy.velocity += direction * forceMagnitude;
-                enemy.isStopped = false;
-            }
-        }
-
-        // 对其他玩家球施加效果
-        for (auto& player : players) {
-            if (&player != &specialBall) {
-                sf::Vector2f delta = player.sprite.getPosition() - specialBall.sprite.getPosition();
-                float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
-
-                if (distance < EFFECT_RADIUS && distance > 0) {
-                    sf::Vector2f direction = delta / distance;
-                    float forceMagnitude = PUSH_FORCE * (1.0f - distance / EFFECT_RADIUS);
-                    player.velocity += direction * forceMagnitude;
-                    player.isStopped = false;
-                }
-            }
-        }
+        world.spawnPlayers();
+        syncPlayerSprites();
     }
 
-    // 事件处理
-    void handleEvents() {
-        sf::Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed)
-                window.close();
-
-            if (currentGameState == Playing) {  // 正常游戏模式
-                handlePlayingStateEvents(event);
-            } 
-            else if (currentGameState == ArchiveView) {  // 存档查看模式
-                handleArchiveViewEvents(event);
-            }
-
-            // V键切换游戏状态
-            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::V) {
-                handleStateTransition();
-            }
+    // 按玩家球体数量重建渲染对象
+    void syncPlayerSprites() {
+        playerSprites.clear();
+        for (size_t i = 0; i < world.playerCount(); ++i) {
+            playerSprites.emplace_back(PLAYER_RADIUS, birdAtlas.getRegion(PLAYER_TEXTURE_FILE));
         }
     }
 
@@ -675,7 +471,7 @@ private:
         }
 
         // 正常游戏模式下保持发射次数限制
-        if (hadshoot < players.size()) {
+        if (hadshoot < world.playerCount()) {
             handleMouseEvents(event);
         }
     }
@@ -687,6 +483,9 @@ private:
             if (event.key.code == sf::Keyboard::Num2) selectedPlayerIndex = 1;
             if (event.key.code == sf::Keyboard::Num3) selectedPlayerIndex = 2;
             if (event.key.code == sf::Keyboard::Num4) selectedPlayerIndex = 3;
+            if (event.key.code == sf::Keyboard::Z) undoShot();
+            if (event.key.code == sf::Keyboard::T) retryShot();
+            if (event.key.code == sf::Keyboard::BackSpace) rewindOneInterval();
         }
 
         // 存档查看模式下无发射次数限制
@@ -706,6 +505,9 @@ private:
         if (event.key.code == sf::Keyboard::S) {
             saveGame("savegame.bin");
         }
+        if (event.key.code == sf::Keyboard::H) {
+            requestHint();
+        }
         if (event.key.code == sf::Keyboard::Num1) selectedPlayerIndex = 0;
         if (event.key.code == sf::Keyboard::Num2) selectedPlayerIndex = 1;
         if (event.key.code == sf::Keyboard::Num3) selectedPlayerIndex = 2;
@@ -735,20 +537,28 @@ private:
             loadGame(FINAL_SAVE_FILE);  
             currentGameState = ArchiveView;
             archiveShootCount = 0;  // 重置额外击球计数
+
+            // 读档后的局面作为第一个击球位置
+            rollback.clear();
+            archiveSteps = 0;
+            rollback.push(world, archiveSteps, archiveShootCount, true);
         } else if (currentGameState == ArchiveView) {
             currentGameState = EndScreen;
+        } else if (currentGameState == ReplayView) {
+            replayPlayer.reset();
+            currentGameState = EndScreen;
         }
     }
 
-    // 更新蓄力状态
-    void updateCharge() {
+    // 更新蓄力状态，按真实经过的时间累加
+    void updateCharge(float elapsed) {
         if (isCharging) {
-            if (currentGameState == Playing && hadshoot >= players.size()) {
+            if (currentGameState == Playing && hadshoot >= world.playerCount()) {
                 // 在正常游戏模式下且已达到发射限制时，不更新蓄力
                 return;
             }
             
-            chargeTime += 0.016f;
+            chargeTime += elapsed;
             if (chargeTime > CHARGE_MAX_TIME) {
                 chargeTime = CHARGE_MAX_TIME;
             }
@@ -758,250 +568,369 @@ private:
 
     // 发射玩家球体
     void launchPlayer(const sf::Vector2f& mousePos) {
-        if (currentGameState == Playing && hadshoot >= players.size()) {
+        if (currentGameState == Playing && hadshoot >= world.playerCount()) {
             // 在正常游戏模式下检查发射限制
             return;
         }
 
-        if (selectedPlayerIndex >= 0 && selectedPlayerIndex < players.size()) {
-            auto& player = players[selectedPlayerIndex];
-            sf::Vector2f direction = mousePos - player.sprite.getPosition();
-            float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
-
-            if (length > 0) {
-                direction /= length;
+        if (selectedPlayerIndex >= 0 && selectedPlayerIndex < world.playerCount()) {
+            if (currentGameState == ArchiveView) saveShotPoint();
+            world.launchPlayer(selectedPlayerIndex, mousePos.x, mousePos.y, chargeTime);
+            if (currentGameState == Playing && recordingReplay) {
+                replayLog.shots.push_back({playedSteps, static_cast<std::uint32_t>(selectedPlayerIndex),
+                                           mousePos.x, mousePos.y, chargeTime});
             }
 
-            player.velocity = direction * (chargeTime / CHARGE_MAX_TIME * 250.f);
-            player.isStopped = false;
-
             // 在这里增加计数，而不是在事件处理中
             if (currentGameState == Playing) {
                 hadshoot++;
+                clearHint();
             } else if (currentGameState == ArchiveView) {
                 archiveShootCount++;
             }
         }
     }
 
+    // 按真实经过的时间推进固定步长的物理模拟
+    void stepSimulation(float elapsed) {
+        int steps = simulationClock.advance(elapsed);
+        for (int i = 0; i < steps; ++i) {
+            updateGameObjects();
+            checkCollisions();
+            collisionAudio.collect(world.events);
+            if (currentGameState == Playing) playedSteps++;
+            if (currentGameState == ArchiveView && ++archiveSteps % ROLLBACK_INTERVAL_STEPS == 0) {
+                rollback.push(world, archiveSteps, archiveShootCount, false);
+            }
+        }
+        collisionAudio.playFrame(elapsed);
+    }
+
     // 更新游戏对象状态
     void updateGameObjects() {
-        for (auto& enemy : enemies) {
-            enemy.updatePosition(0.1f);
-        }
-        for (auto& player : players) {
-            player.updatePosition(0.1f);
-        }
+        world.integrate(simulationClock.stepDt());
     }
 
     // 更新敌人计数和分数
     void updateEnemyCount() {
-        int count = 0;
-        for (const auto &enemy: enemies) {
-            auto bounds = enemy.sprite.getGlobalBounds();
-
-            // 检查敌人是否在中心区域外
-            if (bounds.left + bounds.width <= CENTER_ZONE_POSITION.x ||  // 左侧完全在中心区域外
-                bounds.left >= CENTER_ZONE_POSITION.x + CENTER_ZONE_SIZE.x || // 右侧完全在中心区域外
-                bounds.top + bounds.height <= CENTER_ZONE_POSITION.y ||  // 上侧完全在中心区域外
-                bounds.top >= CENTER_ZONE_POSITION.y + CENTER_ZONE_SIZE.y) { // 下侧完全在中心区域外
-                count++;
-            }
-        }
-
+        int count = world.countEnemiesOutsideZone();
         scoreManager.updateScore(count);
-        scoreText.setString(L"本局分数： " + std::to_wstring(scoreManager.getCurrentScore()));
+        scoreText.set(L"本局分数： ", scoreManager.getCurrentScore());
     }
 
     // 更新游戏信息显示
     void updateMessage() {
-        highScoreText.setString(L"历史记录： " + std::to_wstring(scoreManager.getHighScore()));
-        
+        highScoreText.set(L"历史记录： ", scoreManager.getHighScore());
+
         // 根据游戏状态显示不同的信息
         if (currentGameState == Playing) {
-            playerCountText.setString(L"剩余次数： " + std::to_wstring(std::max(0, (int)players.size() - hadshoot)));
+            playerCountText.set(L"剩余次数： ", std::max(0, (int)world.playerCount() - hadshoot));
         } else if (currentGameState == ArchiveView) {
-            playerCountText.setString(L"额外击球： " + std::to_wstring(archiveShootCount));
+            playerCountText.set(L"额外击球： ", archiveShootCount);
+
+            const std::size_t point = rollback.latestShotPoint();
+            const int best = point < rollback.size() ? rollback.fromNewest(point).bestScore : -1;
+            rollbackText.set(L"Z 撤销  T 重试  退格 倒退  此位置最佳： " +
+                             (best < 0 ? std::wstring(L"无") : std::to_wstring(best)));
         }
     }
 
-    // 检查碰撞
-    void checkCollisions() {
-        // 应用边界碰撞
-        for (auto &player: players) player.applyBoundaryCollision();
-        for (auto &enemy: enemies) enemy.applyBoundaryCollision();
-
-        // 检测玩家与敌人之间的碰撞
-        for (size_t i = 0; i < players.size(); ++i) {
-            for (size_t j = 0; j < enemies.size(); ++j) {
-                CollisionHandler::applyCollision(players[i], enemies[j], collisionSound);
-            }
+    // 击球前保存击球位置；刚重试或撤销回到的位置已经是最新的击球位置，不再重复保存，
+    // 这样从同一位置的多次尝试共用一帧，可以比较它们的分数
+    void saveShotPoint() {
+        if (!rollback.empty()) {
+            const RollbackFrame& newest = rollback.fromNewest(0);
+            if (newest.shotPoint && newest.step == archiveSteps) return;
         }
+        rollback.push(world, archiveSteps, archiveShootCount, true);
+    }
 
-        // 检测玩家之间的碰撞
-        for (size_t i = 0; i < players.size(); ++i) {
-            for (size_t j = i + 1; j < players.size(); ++j) {
-                CollisionHandler::applyCollision(players[i], players[j], collisionSound);
-            }
+    // 回到第 i 帧（从新到旧的序号），丢弃比它新的帧
+    void restoreRollbackFrame(std::size_t i) {
+        const RollbackFrame& frame = rollback.fromNewest(i);
+        world.restoreSnapshot(frame.world);
+        archiveSteps = frame.step;
+        archiveShootCount = frame.shots;
+        rollback.popNewest(i);
+        simulationClock.reset();
+        isCharging = false;
+        updateEnemyCount();
+    }
+
+    // 请求击球提示：场上的球都停止后才有意义，规划在后台进行，最多 PLANNER_BUDGET
+    void requestHint() {
+        if (hintRequest.valid() || static_cast<std::size_t>(hadshoot) >= world.playerCount() || !world.allStopped()) return;
+
+        WorldSnapshot start;
+        world.saveSnapshot(start);
+        hintShots = hadshoot;
+        const std::uint64_t seed = roundSeed + static_cast<std::uint64_t>(hadshoot);
+        hintRequest = std::async(std::launch::async, [this, start = std::move(start), seed] {
+            return hintPlanner.plan(start, seed);
+        });
+        hintText.set(L"提示规划中…");
+    }
+
+    // 规划完成时取回结果并选中建议的鸟（不阻塞）
+    void pollHint() {
+        if (!hintRequest.valid() || hintRequest.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return;
         }
+        const ShotPlan plan = hintRequest.get();
+        if (hintShots != hadshoot) return;  // 规划期间局面已经变了
 
-        // 检测敌人之间的碰撞
-        for (size_t i = 0; i < enemies.size(); ++i) {
-            for (size_t j = i + 1; j < enemies.size(); ++j) {
-                CollisionHandler::applyCollision(enemies[i], enemies[j], collisionSound);
-            }
+        hint = plan;
+        if (!hint.found) {
+            hintText.set(L"没有可用的提示");
+            return;
+        }
+        selectedPlayerIndex = static_cast<int>(hint.player);
+        const int tenths = static_cast<int>(std::lround(hint.charge * 10.f));
+        hintText.set(L"提示：第 " + std::to_wstring(hint.player + 1) + L" 只鸟，蓄力 " + std::to_wstring(tenths / 10) +
+                     L"." + std::to_wstring(tenths % 10) + L" 秒，预计得分 " + std::to_wstring(hint.score));
+    }
+
+    void clearHint() {
+        hint = ShotPlan();
+        hintShots = -1;
+        hintText.set(L"");
+    }
+
+    // 撤销：回到最近一次击球之前；再次撤销继续回到更早的击球之前（最早的位置保留）
+    void undoShot() {
+        std::size_t point = rollback.latestShotPoint();
+        if (point >= rollback.size()) return;
+        if (rollback.fromNewest(point).shots == archiveShootCount && point + 1 < rollback.size()) {
+            // 从这个位置还没有击球：丢弃它，回到再早一次的击球之前
+            rollback.popNewest(point + 1);
+            point = rollback.latestShotPoint();
+            if (point >= rollback.size()) return;
+        }
+        restoreRollbackFrame(point);
+    }
+
+    // 重试：记下这次尝试的分数，回到最近一次击球之前
+    void retryShot() {
+        const std::size_t point = rollback.latestShotPoint();
+        if (point >= rollback.size()) return;
+        RollbackFrame& frame = rollback.fromNewest(point);
+        if (archiveShootCount > frame.shots) {
+            frame.bestScore = std::max(frame.bestScore, world.countEnemiesOutsideZone());
         }
+        restoreRollbackFrame(point);
+    }
+
+    // 倒退：回到早于当前步数的最近一帧（约一个快照间隔）
+    void rewindOneInterval() {
+        const std::size_t i = rollback.latestBefore(archiveSteps);
+        if (i < rollback.size()) restoreRollbackFrame(i);
+    }
+
+    // 检查碰撞
+    void checkCollisions() {
+        world.resolveCollisions();
     }
 
     // 渲染游戏场景
-    void render() {
+    void renderPlayScene() {
         window.clear();
         window.draw(backgroundSprite);
-        window.draw(centerZoneBorder);
-        window.draw(scoreText);
-        window.draw(highScoreText);
-        window.draw(playerCountText);
-        window.draw(chargeBar);
-
-        for (const auto &enemy: enemies) enemy.draw(window);
-        for (const auto &player: players) player.draw(window);
+        scoreText.draw(window);
+        highScoreText.draw(window);
+        playerCountText.draw(window);
+
+        // 边框和蓄力条用图集的纯白区域着色，与小鸟放在同一批
+        spriteBatch.clear();
+        spriteBatch.addOutline(sf::FloatRect(centerZoneBorder.getPosition(), centerZoneBorder.getSize()),
+                               centerZoneBorder.getOutlineThickness(), centerZoneBorder.getOutlineColor());
+        spriteBatch.addRect(sf::FloatRect(chargeBar.getPosition(), chargeBar.getSize()), chargeBar.getFillColor());
+
+        // 每帧从物理状态同步一次精灵，在最近两步之间插值
+        float alpha = currentGameState == ReplayView ? replayPlayer->alpha() : simulationClock.alpha();
+        for (size_t i = 0; i < enemySprites.size(); ++i) enemySprites[i].sync(world.bodies, world.enemyIndex(i), alpha);
+        for (size_t i = 0; i < playerSprites.size(); ++i) playerSprites[i].sync(world.bodies, world.playerIndex(i), alpha);
+
+        for (const auto &enemy: enemySprites) enemy.draw(spriteBatch);
+        for (const auto &player: playerSprites) player.draw(spriteBatch);
+        if (currentGameState == Playing && hint.found) addHintArrow();
+        spriteBatch.draw(window);
 
         window.draw(selectionText);
+        if (currentGameState == ReplayView) replayText.draw(window);
+        if (currentGameState == ArchiveView) rollbackText.draw(window);
+        if (currentGameState == Playing) hintText.draw(window);
         window.display();
     }
 
+    // 提示的方向线：从建议的鸟出发指向目标，长度与蓄力成正比
+    void addHintArrow() {
+        const Body bird = world.getBody(world.playerIndex(hint.player));
+        const float dx = hint.targetX - bird.x;
+        const float dy = hint.targetY - bird.y;
+        const float length = PLAYER_RADIUS + hint.charge / CHARGE_MAX_TIME * 300.f;
+        const float distance = std::sqrt(dx * dx + dy * dy);
+        if (distance <= 0.f) return;
+        const sf::Vector2f center(bird.x + dx / distance * length / 2.f, bird.y + dy / distance * length / 2.f);
+        spriteBatch.addSprite(birdAtlas.getWhiteRegion(), center, sf::Vector2f(length, 6.f),
+                              std::atan2(dy, dx) * 180.f / 3.14159265f, sf::Color(255, 255, 0, 180));
+    }
+
     // 渲染结束场景
     void renderEndScene() {
         window.clear();
         window.draw(backgroundSpriteEnd);
 
-        sf::Text gameOverHighScore;
-        sf::Text gameOverCurrentScore;
-        sf::Text archiveView;
-        sf::Text remainingShots;
-
-        // 设置结束画面文本
-        gameOverHighScore.setFont(font);
-        gameOverHighScore.setString(L"历史记录： " + std::to_wstring(scoreManager.getHighScore()));
-        gameOverHighScore.setCharacterSize(70);
-        gameOverHighScore.setFillColor(sf::Color::White);
-        gameOverHighScore.setPosition(WINDOW_WIDTH / 2 - gameOverHighScore.getGlobalBounds().width / 2, 
-                                    WINDOW_HEIGHT / 2 - gameOverHighScore.getGlobalBounds().height / 2 + 40);
-
-        gameOverCurrentScore.setFont(font);
-        gameOverCurrentScore.setString(L"本局分数： " + std::to_wstring(scoreManager.getCurrentScore()));
-        gameOverCurrentScore.setCharacterSize(70);
-        gameOverCurrentScore.setFillColor(sf::Color::White);
-        gameOverCurrentScore.setPosition(WINDOW_WIDTH / 2 - gameOverCurrentScore.getGlobalBounds().width / 2, 
-                                       WINDOW_HEIGHT / 2 - gameOverCurrentScore.getGlobalBounds().height / 2 - 100);
-
-        archiveView.setFont(font);
-        archiveView.setString(L"按 V 键查看存档，再次按 V 返回");
-        archiveView.setCharacterSize(40);
-        archiveView.setFillColor(sf::Color::White);
-        archiveView.setPosition(WINDOW_WIDTH / 2 - archiveView.getGlobalBounds().width / 2, WINDOW_HEIGHT - 200);
+        // 文本只在分数变化时重新生成和排版
+        endHighScoreText.set(L"历史记录： ", scoreManager.getHighScore());
+        endCurrentScoreText.set(L"本局分数： ", scoreManager.getCurrentScore());
 
         // 绘制结束画面元素
-        window.draw(gameOverHighScore);
-        window.draw(gameOverCurrentScore);
-        window.draw(archiveView);
-        window.draw(remainingShots);
+        endHighScoreText.draw(window);
+        endCurrentScoreText.draw(window);
+        archiveHintText.draw(window);
         window.display();
     }
 
-    void saveGame(const std::string& filename) {
-        std::ofstream file(filename, std::ios::binary);
-        if (file.is_open()) {
-            // 保存当前分数
-            int currentScore = scoreManager.getCurrentScore();
-            file.write(reinterpret_cast<const char*>(&currentScore), sizeof(int));
-            
-            // 保存已发射次数
-            file.write(reinterpret_cast<const char*>(&hadshoot), sizeof(int));
-
-            // 保存额外击球次数
-            file.write(reinterpret_cast<const char*>(&archiveShootCount), sizeof(int));
-
-            // 保存敌方球体状态
-            int enemyCount = enemies.size();
-            file.write(reinterpret_cast<const char*>(&enemyCount), sizeof(int));
-            for (const auto& enemy : enemies) {
-                enemy.save(file);
-            }
+    // 保存本局的回放（格式见 Replay.h）；读过档的对局无法按种子重现，不保存
+    void saveReplay(const std::string& filename) {
+        if (!recordingReplay) return;
+        replayLog.endStep = playedSteps;
+        if (!ReplayFile::write(filename, replayLog)) {
+            std::cerr << "Error saving replay!" << std::endl;
+        }
+    }
 
-            // 保存玩家球体状态
-            int playerCount = players.size();
-            file.write(reinterpret_cast<const char*>(&playerCount), sizeof(int));
-            for (const auto& player : players) {
-                player.save(file);
-            }
+    // 读取整局回放，从种子重新生成布局后开始播放
+    void startReplay() {
+        ReplayLog log;
+        if (!ReplayFile::read(FINAL_REPLAY_FILE, log)) {
+            std::cerr << "Error loading replay!" << std::endl;
+            return;
+        }
+        replayPlayer = std::make_unique<ReplayPlayer>(world, std::move(log));
+        enemySprites.assign(world.enemyCount(), GameObject(ENEMY_RADIUS, birdAtlas.getRegion(ENEMY_TEXTURE_FILE)));
+        syncPlayerSprites();
+        isCharging = false;
+        currentGameState = ReplayView;
+        updateReplayText();
+    }
+
+    // 回放控制：空格暂停/继续（播放完毕时从头开始），左右方向键跳转，上下方向键变速，Home 回到开头
+    void handleReplayEvents(const sf::Event& event) {
+        if (event.type != sf::Event::KeyPressed) return;
+
+        ReplayPlayer& player = *replayPlayer;
+        const std::uint32_t seekSteps = static_cast<std::uint32_t>(REPLAY_SEEK_SECONDS * PHYSICS_STEP_RATE);
+        switch (event.key.code) {
+            case sf::Keyboard::Space:
+                if (player.finished()) {
+                    player.seek(0);
+                    player.setPaused(false);
+                } else {
+                    player.setPaused(!player.isPaused());
+                }
+                break;
+            case sf::Keyboard::Right:
+                player.seek(player.getStep() + seekSteps);
+                break;
+            case sf::Keyboard::Left:
+                player.seek(player.getStep() > seekSteps ? player.getStep() - seekSteps : 0);
+                break;
+            case sf::Keyboard::Up:
+                player.setSpeed(std::min(player.getSpeed() * 2.f, REPLAY_MAX_SPEED));
+                break;
+            case sf::Keyboard::Down:
+                player.setSpeed(std::max(player.getSpeed() / 2.f, REPLAY_MIN_SPEED));
+                break;
+            case sf::Keyboard::Home:
+                player.seek(0);
+                break;
+            default:
+                break;
+        }
+        updateReplayText();
+    }
+
+    // 回放进度（整秒）、速度和操作提示，内容变化时才重新排版
+    void updateReplayText() {
+        const ReplayPlayer& player = *replayPlayer;
+        const int current = static_cast<int>(player.getStep() / PHYSICS_STEP_RATE);
+        const int total = static_cast<int>(player.getEndStep() / PHYSICS_STEP_RATE);
+        const float speed = player.getSpeed();
+        const std::wstring speedText = speed >= 1.f ? std::to_wstring(static_cast<int>(speed))
+                                                    : L"1/" + std::to_wstring(static_cast<int>(1.f / speed));
+        std::wstring text = L"回放 " + std::to_wstring(current) + L" / " + std::to_wstring(total) + L" 秒  ×" +
+                            speedText;
+        if (player.finished()) {
+            text += L"  已结束";
+        } else if (player.isPaused()) {
+            text += L"  已暂停";
+        }
+        text += L"    空格 暂停  ←→ 跳转  ↑↓ 变速  V 返回";
+        replayText.set(text);
+    }
+
+    // 保存当前局面（格式见 SaveFile.h）
+    void saveGame(const std::string& filename) {
+        SaveState state;
+        state.score = scoreManager.getCurrentScore();
+        state.shotsFired = hadshoot;
+        state.extraShots = archiveShootCount;
+        state.seed = roundSeed;
+        state.enemies.reserve(world.enemyCount());
+        for (size_t i = 0; i < world.enemyCount(); ++i) {
+            state.enemies.push_back(world.getBody(world.enemyIndex(i)));
+        }
+        state.players.reserve(world.playerCount());
+        for (size_t i = 0; i < world.playerCount(); ++i) {
+            state.players.push_back(world.getBody(world.playerIndex(i)));
+        }
 
-            file.close();
-        } else {
+        if (!SaveFile::write(filename, state)) {
             std::cerr << "Error saving game!" << std::endl;
         }
     }
 
+    // 读取存档；文件不存在、版本不符或已损坏时保持当前局面不变
     void loadGame(const std::string& filename) {
-        std::ifstream file(filename, std::ios::binary);
-        if (file.is_open()) {
-            // 加载当前分数
-            int loadedScore;
-            file.read(reinterpret_cast<char*>(&loadedScore), sizeof(int));
-            scoreManager.updateScore(loadedScore);
-            
-            // 加载已发射次数
-            file.read(reinterpret_cast<char*>(&hadshoot), sizeof(int));
-
-            // 加载额外击球次数
-            file.read(reinterpret_cast<char*>(&archiveShootCount), sizeof(int));
-
-            // 加载敌方球体状态
-            int enemyCount;
-            file.read(reinterpret_cast<char*>(&enemyCount), sizeof(int));
-            enemies.clear();
-            for (int i = 0; i < enemyCount; ++i) {
-                enemies.emplace_back(ENEMY_RADIUS, "Images/bird_2.png", sf::Vector2f(0, 0), textureManager);
-                enemies.back().load(file);
-            }
+        SaveState state;
+        if (!SaveFile::read(filename, state)) {
+            std::cerr << "Error loading game!" << std::endl;
+            return;
+        }
 
-            // 加载玩家球体状态
-            int playerCount;
-            file.read(reinterpret_cast<char*>(&playerCount), sizeof(int));
-            players.clear();
-            for (int i = 0; i < playerCount; ++i) {
-                players.emplace_back(PLAYER_RADIUS, "Images/bird_1.png", sf::Vector2f(0, 0), textureManager);
-                players.back().load(file);
-            }
+        scoreManager.updateScore(state.score);
+        hadshoot = state.shotsFired;
+        recordingReplay = false;
+        clearHint();
+        archiveShootCount = state.extraShots;
+        roundSeed = state.seed;
+
+        // 加载敌方球体状态
+        world.clear();
+        for (const Body& enemy : state.enemies) {
+            world.addEnemy(enemy);
+        }
+        enemySprites.assign(state.enemies.size(),
+                            GameObject(ENEMY_RADIUS, birdAtlas.getRegion(ENEMY_TEXTURE_FILE)));
+
+        // 加载玩家球体状态
+        for (size_t i = 0; i < state.players.size(); ++i) {
+            Body player = state.players[i];
 
-            // 重新设置特殊球的回调函数和状态
-            auto specialEffect = [this](GameObject& ball) {
-                this->triggerSpecialEffect(ball);
-            };
-            
             // 为第3和第4个球重新设置特殊效果
-            if (players.size() > 2) {
-                players[2].isSpecial = true;
-                players[2].onSpecialEffect = specialEffect;
-                // 如果球已经被发射但还没触发效果，重置其触发状态
-                if (players[2].hasBeenLaunched && players[2].hasTriggeredSpecial) {
-                    players[2].hasTriggeredSpecial = false;
-                }
-            }
-            if (players.size() > 3) {
-                players[3].isSpecial = true;
-                players[3].onSpecialEffect = specialEffect;
+            if (i == 2 || i == 3) {
+                player.isSpecial = true;
                 // 如果球已经被发射但还没触发效果，重置其触发状态
-                if (players[3].hasBeenLaunched && players[3].hasTriggeredSpecial) {
-                    players[3].hasTriggeredSpecial = false;
+                if (player.hasBeenLaunched && player.hasTriggeredSpecial) {
+                    player.hasTriggeredSpecial = false;
                 }
             }
-
-            file.close();
-            viewArchiveMode = false;
-            currentGameState = Playing;  // 确保状态被重置为Playing
-        } else {
-            std::cerr << "Error loading game!" << std::endl;
+            world.addPlayer(player);
         }
+        syncPlayerSprites();
+
+        viewArchiveMode = false;
+        currentGameState = Playing;  // 确保状态被重置为Playing
     }
 };
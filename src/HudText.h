@@ -0,0 +1,68 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <initializer_list>
+#include <string>
+
+// HUD 文本：缓存字符串和字形几何，只有标签或数值变化时才重新生成。
+// 位置由锚点和对齐比例决定（对齐比例乘以文本尺寸后从锚点减去），用于居中等排版
+class HudText {
+public:
+    void setup(const sf::Font& font, unsigned size, sf::Vector2f anchor,
+               sf::Vector2f pivot = sf::Vector2f(0.f, 0.f), sf::Color color = sf::Color::White) {
+        text.setFont(font);
+        text.setCharacterSize(size);
+        text.setFillColor(color);
+        this->anchor = anchor;
+        this->pivot = pivot;
+        place();
+    }
+
+    // 显示“标签 + 数值”，与上次相同时什么也不做
+    void set(const std::wstring& newLabel, int newValue) {
+        if (hasValue && value == newValue && label == newLabel) return;
+        label = newLabel;
+        value = newValue;
+        hasValue = true;
+        text.setString(label + std::to_wstring(value));
+        place();
+    }
+
+    // 显示固定文本
+    void set(const std::wstring& newLabel) {
+        if (!hasValue && label == newLabel) return;
+        label = newLabel;
+        hasValue = false;
+        text.setString(label);
+        place();
+    }
+
+    void draw(sf::RenderTarget& target) const {
+        target.draw(text);
+    }
+
+    // 预先生成字形：把 characters 中的字符在各字号下光栅化到字体的字形纹理中，
+    // 避免第一次显示新数字或新标签时卡顿
+    static void warmUpGlyphs(const sf::Font& font, const std::wstring& characters,
+                             std::initializer_list<unsigned> sizes) {
+        for (unsigned size : sizes) {
+            for (wchar_t c : characters) {
+                font.getGlyph(static_cast<sf::Uint32>(c), size, false);
+            }
+        }
+    }
+
+private:
+    sf::Text text;                      // 缓存的文本（字形几何由 SFML 在字符串变化时重建）
+    std::wstring label;                 // 当前标签
+    int value = 0;                      // 当前数值
+    bool hasValue = false;              // 是否显示数值
+    sf::Vector2f anchor;                // 锚点
+    sf::Vector2f pivot;                 // 对齐比例：(0, 0) 左上角，(0.5, 0.5) 居中
+
+    // 按当前文本尺寸重新计算位置（只在内容变化时调用）
+    void place() {
+        const sf::FloatRect bounds = text.getLocalBounds();
+        text.setPosition(anchor.x - bounds.width * pivot.x, anchor.y - bounds.height * pivot.y);
+    }
+};
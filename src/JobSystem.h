@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// 任务系统：每个线程一个双端队列，自己从队尾取任务，空闲时从其他队列的队首窃取。
+// 调用 parallelFor 的线程使用 0 号队列并一起执行，直到本批任务全部完成后返回；
+// 任务内部可以再次调用 parallelFor（等待期间会继续执行其他任务，不会死锁）。
+class JobSystem {
+public:
+    // threads 为参与执行的线程总数（含调用线程），0 表示使用全部硬件线程
+    explicit JobSystem(unsigned threads = 0) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        threadTotal = threads;
+        queues = std::make_unique<Queue[]>(threads);
+        for (unsigned i = 1; i < threads; ++i) {
+            workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    unsigned threadCount() const {
+        return threadTotal;
+    }
+
+    // 把 [begin, end) 按 grain 切块，并行执行 fn(块起点, 块终点)。
+    // 切块只取决于 grain，与线程数无关
+    template <typename Fn>
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Fn&& fn) {
+        if (end <= begin) return;
+        grain = std::max<std::size_t>(grain, 1);
+        const std::size_t chunks = (end - begin + grain - 1) / grain;
+
+        // 单线程或只有一块时直接在调用线程上执行
+        if (threadTotal == 1 || chunks == 1) {
+            for (std::size_t b = begin; b < end; b += grain) {
+                fn(b, std::min(b + grain, end));
+            }
+            return;
+        }
+
+        Batch batch;
+        batch.context = &fn;
+        batch.run = [](void* context, std::size_t b, std::size_t e) {
+            (*static_cast<std::remove_reference_t<Fn>*>(context))(b, e);
+        };
+        batch.remaining.store(chunks, std::memory_order_relaxed);
+
+        // 各块轮流放入各个队列，工作线程先做自己队列里的，做完再去窃取
+        for (std::size_t c = 0; c < chunks; ++c) {
+            const std::size_t b = begin + c * grain;
+            Queue& queue = queues[c % threadTotal];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_back({&batch, b, std::min(b + grain, end)});
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            epoch++;
+        }
+        wakeUp.notify_all();
+
+        // 调用线程也参与执行，直到本批任务全部完成
+        while (batch.remaining.load(std::memory_order_acquire) > 0) {
+            Job job;
+            if (popOrSteal(0, job)) {
+                execute(job);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    // 一次 parallelFor 调用：类型擦除后的函数和未完成的块数
+    struct Batch {
+        void* context = nullptr;
+        void (*run)(void*, std::size_t, std::size_t) = nullptr;
+        std::atomic<std::size_t> remaining{0};
+    };
+
+    // 一个块
+    struct Job {
+        Batch* batch = nullptr;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    unsigned threadTotal = 1;
+    std::unique_ptr<Queue[]> queues;            // 每个线程一个队列，0 号属于调用线程
+    std::vector<std::thread> workers;
+
+    // 没有任务时工作线程在此等待
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::uint64_t epoch = 0;                    // 每提交一批任务加一
+    bool stopping = false;
+
+    static void execute(const Job& job) {
+        job.batch->run(job.batch->context, job.begin, job.end);
+        job.batch->remaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    // 先从自己的队尾取，再依次从其他队列的队首窃取
+    bool popOrSteal(unsigned self, Job& job) {
+        {
+            Queue& own = queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.jobs.empty()) {
+                job = own.jobs.back();
+                own.jobs.pop_back();
+                return true;
+            }
+        }
+        for (unsigned k = 1; k < threadTotal; ++k) {
+            Queue& victim = queues[(self + k) % threadTotal];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.jobs.empty()) {
+                job = victim.jobs.front();
+                victim.jobs.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(unsigned self) {
+        std::uint64_t seen = 0;
+        for (;;) {
+            Job job;
+            if (popOrSteal(self, job)) {
+                execute(job);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wakeUp.wait(lock, [&] { return stopping || epoch != seen; });
+            if (stopping) return;
+            seen = epoch;
+        }
+    }
+};
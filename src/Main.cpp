@@ -1,4 +1,4 @@
-#include "Menu.h"
+#include "Application.h"
 
 int main() {
     Application app;
@@ -3,8 +3,13 @@
 #include <SFML/Graphics.hpp>
 #include <memory>
 #include <iostream>
+#include "Scene.h"
 #include "Game.h"
 
+// 菜单用到的图片（窗口创建后立即开始后台解码）
+constexpr const char* MENU_IMAGE_FILES[] = {"Images/background_image.png", "Images/start_icon.png",
+                                            "Images/second_page.png", "Images/second_botton.png"};
+
 // 动画效果类：实现界面过渡动画
 class Easing {
 public:
@@ -49,34 +54,32 @@ public:
 // 背景类：处理背景图片的加载和显示
 class Background {
 private:
-    sf::Texture m_texture;  // 背景纹理
+    TextureRef m_texture;   // 背景纹理（来自共享的纹理缓存）
     sf::Sprite m_sprite;    // 背景精灵
 
 public:
-    // 构造函数：加载并设置背景
-    Background(const std::string& filePath, const sf::RenderWindow& window) {
-        loadTexture(filePath);
-        scaleSprite(window);
-    }
-
-    // 加载背景纹理
-    void loadTexture(const std::string& filePath) {
-        if (!m_texture.loadFromFile(filePath)) {
+    // 从纹理缓存取得背景纹理（图片已在后台解码，这里通常只需上传）
+    void loadTexture(TextureManager& textures, const std::string& filePath) {
+        try {
+            m_texture = textures.acquire(filePath);
+            m_sprite.setTexture(m_texture.get(), true);
+        } catch (const std::runtime_error&) {
             std::cerr << "Failed to load image: " << filePath << std::endl;
         }
-        m_sprite.setTexture(m_texture);
     }
 
     // 缩放背景以适应窗口
     void scaleSprite(const sf::RenderWindow& window) {
+        if (!m_sprite.getTexture()) return;
+        const sf::Vector2u textureSize = m_sprite.getTexture()->getSize();
         float windowAspectRatio = static_cast<float>(window.getSize().x) / window.getSize().y;
-        float textureAspectRatio = static_cast<float>(m_texture.getSize().x) / m_texture.getSize().y;
+        float textureAspectRatio = static_cast<float>(textureSize.x) / textureSize.y;
 
         if (windowAspectRatio > textureAspectRatio) {
-            float scaleX = window.getSize().x / static_cast<float>(m_texture.getSize().x);
+            float scaleX = window.getSize().x / static_cast<float>(textureSize.x);
             m_sprite.setScale(scaleX, scaleX);
         } else {
-            float scaleY = window.getSize().y / static_cast<float>(m_texture.getSize().y);
+            float scaleY = window.getSize().y / static_cast<float>(textureSize.y);
             m_sprite.setScale(scaleY, scaleY);
         }
     }
@@ -92,21 +95,31 @@ public:
     }
 };
 
-// 应用程序类：管理整个游戏流程
-class Application {
+// 菜单场景：封面和说明页，点击开始后请求切换到游戏场景
+class MenuScene : public Scene {
 private:
+    // 共享的窗口和资源
+    sf::RenderWindow& window;             // 主窗口
+    AssetLoader& assets;                  // 后台资源加载
+    TextureManager& textures;             // 纹理缓存
+    const sf::Font& font;                 // 字体
+    SceneId requestedScene;               // 请求切换到的场景
+
     // 窗口和渲染相关
-    sf::RenderWindow window;              // 主窗口
-    sf::RenderTexture renderTexture;      // 渲染纹理
+    sf::RenderTexture renderTexture;      // 渲染纹理（只在创建和窗口大小改变时分配）
+    sf::Sprite renderSprite;              // 把渲染纹理画到窗口上的精灵
     float alpha;                          // 透明度值
 
+    // 重绘标记：画面没有变化时不重绘，空闲时阻塞等待事件
+    bool redrawRequested;                 // 窗口画面需要重绘
+    bool layerDirty;                      // 渲染纹理中的页面内容需要重绘
+
     // 背景和按钮相关
     Background background;                 // 背景对象
-    sf::Texture buttonTexture;            // 开始按钮纹理
+    TextureRef buttonTexture;             // 开始按钮纹理
     std::unique_ptr<Button> button;       // 开始按钮
-    sf::Texture buttonTexture2;           // 第二按钮纹理
+    TextureRef buttonTexture2;            // 第二按钮纹理
     std::unique_ptr<Button> button2;      // 第二按钮
-    sf::Image icon;                       // 图标成员变量
 
     // 过渡动画相关
     bool isTransitioning;                 // 是否正在过渡
@@ -114,12 +127,13 @@ private:
     float currentTime;                    // 当前时间
     sf::Clock clock;                      // 时钟
     int currentPage;                      // 当前页面
+    float longestTransitionFrame;         // 本次过渡动画中最长的一帧（秒）
 
     // 说明页面相关
     bool showInstructions;                    // 控制说明页面显示
     sf::RectangleShape instructionBackground; // 说明页面背景
     std::vector<sf::Text> instructionLines;   // 说明文本行
-    sf::Font font;                            // 字体
+    sf::View instructionView;                 // 说明文本的视图：滚动即移动视图，视口之外的部分被裁掉
 
     // 添加滚动相关变量
     float scrollOffset;          // 文本滚动偏移量
@@ -128,153 +142,47 @@ private:
 
     sf::Text helpPrompt;  // 添加提示文本成员变量
 
-    // 处理输入事件
-    void processEvents() {
-        sf::Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) {
-                window.close();
-            }
-
-            // P 键事件处理 - 只在第二页时有效
-            if (currentPage == 2 && event.type == sf::Event::KeyPressed) {
-                if (event.key.code == sf::Keyboard::P) {
-                    showInstructions = !showInstructions;
-                    std::cout << "Instructions toggled: " << (showInstructions ? "shown" : "hidden") << std::endl;  // 调试输出
-                }
-            }
-
-            // 现有的鼠标点击事件处理
-            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
-                if (button && button->isClicked(sf::Mouse::getPosition(window)) && currentPage == 1) {
-                    background.loadTexture("Images/second_page.png");
-                    background.scaleSprite(window);
-                    startTransition();
-                    currentPage = 2;
-                    button.reset();
-                } else if (button2 && button2->isClicked(sf::Mouse::getPosition(window)) && currentPage == 2) {
-                    background.loadTexture("Images/background.png");
-                    background.scaleSprite(window);
-                    startTransition();
-                    currentPage = 3;
-                    button2.reset();
-                    switchToGame();
-                }
-            }
-
-            // 添加鼠标滚轮事件处理
-            if (currentPage == 2 && showInstructions && event.type == sf::Event::MouseWheelScrolled) {
-                if (event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel) {
-                    // 向上滚动是负值，向下滚动是正值，所以要取反
-                    float delta = -event.mouseWheelScroll.delta * scrollSpeed;
-                    
-                    // 更新滚动偏移量，并确保在有效范围内
-                    scrollOffset = std::clamp(scrollOffset + delta, 0.f, maxScrollOffset);
-                }
-            }
-        }
-    }
-
     // 开始过渡动画
     void startTransition() {
         isTransitioning = true;
         currentTime = 0.0f;
+        longestTransitionFrame = 0.f;
         clock.restart();
     }
 
-    // 更新游戏状态
-    void update() {
-        if (isTransitioning) {
-            currentTime += clock.restart().asSeconds();
-            // 检查过渡动画是否完成
-            if (currentTime >= transitionTime) {
-                isTransitioning = false;
-                currentTime = 0.0f;
-            }
-        }
-    }
-
-    // 渲染画面
-    void render() {
+    // 按窗口大小（重新）创建渲染纹理
+    void resizeRenderTexture() {
         if (!renderTexture.create(window.getSize().x, window.getSize().y)) {
-            std::cerr << "Failed to create render texture!" << std::endl;
-            return;
-        }
-
-        renderTexture.clear(sf::Color::Transparent);
-        background.draw(renderTexture);
-        
-        // 在第二页时显示按钮和提示文本
-        if (currentPage == 2) {
-            if (button2) {
-                button2->draw(renderTexture, isTransitioning ? alpha : 255.0f);
-            }
-
-            // 设置并绘制提示文本
-            helpPrompt.setString(L"按 P 键查看游戏说明");
-            helpPrompt.setCharacterSize(72);  
-            helpPrompt.setCharacterSize(72);
-            helpPrompt.setFillColor(sf::Color(25, 25, 112));  
-            
-            
-            // 调整位置到按钮附近
-            helpPrompt.setPosition(840, 820); 
-            
-            renderTexture.draw(helpPrompt);
-        } else if (currentPage == 1 && button) {
-            button->draw(renderTexture, 255.0f);
-        }
-
-        renderTexture.display();
-
-        sf::Sprite renderSprite(renderTexture.getTexture());
-        window.clear();
-        window.draw(renderSprite);
-
-        if (isTransitioning) {
-            alpha = Easing::quadraticEaseInOut(currentTime, 255.0f, -255.0f, transitionTime);
-            sf::RectangleShape overlay(sf::Vector2f(window.getSize()));
-            overlay.setFillColor(sf::Color(255, 255, 255, static_cast<uint8_t>(alpha)));
-            window.draw(overlay);
-        }
-
-        // 在第二页且需要显示说明时绘制说明页面
-        if (currentPage == 2 && showInstructions) {
-            window.draw(instructionBackground);
-            
-            // 获取说明背景的边界作为剪切区域
-            float topY = instructionBackground.getPosition().y;
-            float bottomY = topY + instructionBackground.getSize().y;
-            
-            // 绘制文本
-            for (const auto& text : instructionLines) {
-                sf::Text scrolledText = text;
-                float newY = text.getPosition().y - scrollOffset;
-                scrolledText.setPosition(text.getPosition().x, newY);
-                
-                // 只绘制在背景区域内的文本
-                float textTop = scrolledText.getPosition().y;
-                float textBottom = textTop + scrolledText.getCharacterSize();
-                
-                if (textBottom >= topY+50 && textTop <= bottomY-50) {
-                    window.draw(scrolledText);
-                }
-            }
+            throw std::runtime_error("Failed to create render texture!");
         }
+        renderSprite.setTexture(renderTexture.getTexture(), true);
+    }
 
-        window.display();
+    // 按滚动偏移量更新说明视图：视口固定在说明背景内，视图区域随滚动下移
+    void updateInstructionView() {
+        const sf::Vector2f position = instructionBackground.getPosition();
+        const sf::Vector2f size = instructionBackground.getSize();
+        const sf::Vector2f screen = window.getDefaultView().getSize();
+        const float margin = 50.f;
+
+        const sf::FloatRect visible(position.x, position.y + margin, size.x, size.y - margin * 2);
+        instructionView.reset(sf::FloatRect(visible.left, visible.top + scrollOffset, visible.width, visible.height));
+        instructionView.setViewport(sf::FloatRect(visible.left / screen.x, visible.top / screen.y,
+                                                  visible.width / screen.x, visible.height / screen.y));
     }
 
-    // 切换到游戏场景
+    // 切换到游戏场景：由 Application 在本帧结束后销毁菜单、创建游戏场景
     void switchToGame() {
-        // 确保在切换前释放资源
-        button.reset();
-        button2.reset();
-        renderTexture.clear();
-        
-        Game game;
-        window.close();
-        game.run();
+        requestedScene = SceneId::Play;
+    }
+
+    // 从纹理缓存取得纹理，失败时抛出异常
+    TextureRef loadTexture(const std::string& filePath) {
+        try {
+            return textures.acquire(filePath);
+        } catch (const std::runtime_error&) {
+            throw std::runtime_error("Failed to load " + filePath);
+        }
     }
 
     void initializeInstructions() {
@@ -355,49 +263,47 @@ private:
                                       (instructionBackground.getPosition().y + visibleHeight));
         scrollOffset = 0.f;
         scrollSpeed = 40.f;
+        updateInstructionView();
     }
 
 public:
-    // 构造函数：初始化应用程序
-    Application()
-            : window(sf::VideoMode(1920, 1080), L"哐哐当当雀雀球"),
-              background("Images/background_image.png", window),
+    // 构造函数：使用共享的窗口和资源初始化菜单
+    explicit MenuScene(const SceneContext& context)
+            : window(context.window),
+              assets(context.assets),
+              textures(context.textures),
+              font(context.font),
+              requestedScene(SceneId::None),
               isTransitioning(false), 
               transitionTime(2.0f), 
               currentTime(0.0f), 
               currentPage(1),
+              longestTransitionFrame(0.f),
               alpha(255.0f),
+              redrawRequested(true),
+              layerDirty(true),
               showInstructions(false),
               scrollOffset(0.f),
               scrollSpeed(30.f),
               maxScrollOffset(0.f)  // 将在 initializeInstructions 中计算
     {
-        // 加载并设置窗口图标
-       if (icon.loadFromFile("Images/bird_2.png")) {
-           window.setIcon(icon.getSize().x, icon.getSize().y, icon.getPixelsPtr());
-       }
+        // 菜单两页的图片一起开始后台解码
+        for (const char* file : MENU_IMAGE_FILES) {
+            assets.prefetchImage(file);
+        }
+        background.loadTexture(textures, "Images/background_image.png");
+        background.scaleSprite(window);
 
         // 初始化渲染纹理
-        if (!renderTexture.create(window.getSize().x, window.getSize().y)) {
-            throw std::runtime_error("Failed to create render texture!");
-        }
+        resizeRenderTexture();
 
         // 初始化开始按钮
-        if (!buttonTexture.loadFromFile("Images/start_icon.png")) {
-            throw std::runtime_error("Failed to load start button icon!");
-        }
-        button = std::make_unique<Button>(buttonTexture, sf::Vector2f(1359, 927), background.getScale());
+        buttonTexture = loadTexture("Images/start_icon.png");
+        button = std::make_unique<Button>(buttonTexture.get(), sf::Vector2f(1359, 927), background.getScale());
 
         // 初始化第二个按钮
-        if (!buttonTexture2.loadFromFile("Images/second_botton.png")) {
-            throw std::runtime_error("Failed to load second button!");
-        }
-        button2 = std::make_unique<Button>(buttonTexture2, sf::Vector2f(1567, 993));
-
-        // 加载字体
-        if (!font.loadFromFile("chinese.ttf")) {
-            throw std::runtime_error("Failed to load font!");
-        }
+        buttonTexture2 = loadTexture("Images/second_botton.png");
+        button2 = std::make_unique<Button>(buttonTexture2.get(), sf::Vector2f(1567, 993));
 
         // 初始化说明页面背景
         instructionBackground.setSize(sf::Vector2f(1200, 800));
@@ -410,19 +316,147 @@ public:
         // 初始化说明文本
         initializeInstructions();
 
-        // 初始化提示文本
+        // 初始化提示文本（位于第二页按钮附近）
         helpPrompt.setFont(font);
-        helpPrompt.setCharacterSize(48);
-        helpPrompt.setFillColor(sf::Color::White);
+        helpPrompt.setCharacterSize(72);
+        helpPrompt.setFillColor(sf::Color(25, 25, 112));
         helpPrompt.setString(L"按 P 键查看游戏说明");
+        helpPrompt.setPosition(840, 820);
+    }
+
+    // 处理一个输入事件
+    void handleEvent(const sf::Event& event) override {
+        // 窗口大小改变时重新分配渲染纹理
+        if (event.type == sf::Event::Resized) {
+            resizeRenderTexture();
+            background.scaleSprite(window);
+            layerDirty = true;
+            redrawRequested = true;
+        }
+
+        // 窗口重新获得焦点时内容可能已被覆盖
+        if (event.type == sf::Event::GainedFocus) {
+            redrawRequested = true;
+        }
+
+        // P 键事件处理 - 只在第二页时有效
+        if (currentPage == 2 && event.type == sf::Event::KeyPressed) {
+            if (event.key.code == sf::Keyboard::P) {
+                showInstructions = !showInstructions;
+                redrawRequested = true;
+                std::cout << "Instructions toggled: " << (showInstructions ? "shown" : "hidden") << std::endl;  // 调试输出
+            }
+        }
+
+        // 现有的鼠标点击事件处理
+        if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+            if (button && button->isClicked(sf::Mouse::getPosition(window)) && currentPage == 1) {
+                // 第二页的图片在第一页期间已预取，这里通常只需上传
+                sf::Clock loadClock;
+                background.loadTexture(textures, "Images/second_page.png");
+                background.scaleSprite(window);
+                std::cout << "切换到第二页: 加载 " << loadClock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+                startTransition();
+                currentPage = 2;
+                button.reset();
+                layerDirty = true;
+
+                // 停留在第二页期间预取游戏场景的资源
+                Game::prefetchAssets(assets);
+            } else if (button2 && button2->isClicked(sf::Mouse::getPosition(window)) && currentPage == 2) {
+                // 游戏场景有自己的背景，这里不再加载
+                startTransition();
+                currentPage = 3;
+                button2.reset();
+                switchToGame();
+            }
+        }
+
+        // 添加鼠标滚轮事件处理
+        if (currentPage == 2 && showInstructions && event.type == sf::Event::MouseWheelScrolled) {
+            if (event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel) {
+                // 向上滚动是负值，向下滚动是正值，所以要取反
+                float delta = -event.mouseWheelScroll.delta * scrollSpeed;
+                
+                // 更新滚动偏移量，并确保在有效范围内
+                scrollOffset = std::clamp(scrollOffset + delta, 0.f, maxScrollOffset);
+                updateInstructionView();
+                redrawRequested = true;
+            }
+        }
+    }
+
+    // 更新过渡动画（使用自己的时钟：空闲等待事件的时间不计入动画）
+    void update(float) override {
+        if (isTransitioning) {
+            float frameTime = clock.restart().asSeconds();
+            currentTime += frameTime;
+            longestTransitionFrame = std::max(longestTransitionFrame, frameTime);
+            // 检查过渡动画是否完成
+            if (currentTime >= transitionTime) {
+                isTransitioning = false;
+                currentTime = 0.0f;
+                std::cout << "过渡动画最长帧: " << longestTransitionFrame * 1000.f << " ms" << std::endl;
+                // 再画一帧不带遮罩、按钮完全不透明的画面
+                layerDirty = true;
+                redrawRequested = true;
+            }
+        }
     }
 
-    // 运行应用程序
-    void run() {
-        while (window.isOpen()) {
-            processEvents();
-            update();
-            render();
+    // 渲染画面
+    void render() override {
+        // 页面内容（背景、按钮、提示）画在渲染纹理中，只在变化或过渡动画期间重绘
+        if (layerDirty || isTransitioning) {
+            renderTexture.clear(sf::Color::Transparent);
+            background.draw(renderTexture);
+
+            // 在第二页时显示按钮和提示文本
+            if (currentPage == 2) {
+                if (button2) {
+                    button2->draw(renderTexture, isTransitioning ? alpha : 255.0f);
+                }
+                renderTexture.draw(helpPrompt);
+            } else if (currentPage == 1 && button) {
+                button->draw(renderTexture, 255.0f);
+            }
+
+            renderTexture.display();
+            layerDirty = false;
+        }
+
+        window.clear();
+        window.draw(renderSprite);
+
+        if (isTransitioning) {
+            alpha = Easing::quadraticEaseInOut(currentTime, 255.0f, -255.0f, transitionTime);
+            sf::RectangleShape overlay(sf::Vector2f(window.getSize()));
+            overlay.setFillColor(sf::Color(255, 255, 255, static_cast<uint8_t>(alpha)));
+            window.draw(overlay);
         }
+
+        // 在第二页且需要显示说明时绘制说明页面
+        if (currentPage == 2 && showInstructions) {
+            window.draw(instructionBackground);
+
+            // 文本在说明视图中绘制，视口只覆盖背景上下各留 50 像素后的区域
+            window.setView(instructionView);
+            for (const auto& text : instructionLines) {
+                window.draw(text);
+            }
+            window.setView(window.getDefaultView());
+        }
+
+        window.display();
+        redrawRequested = false;
+    }
+
+    // 画面没有变化时不重绘
+    bool needsRedraw() const override {
+        return redrawRequested || isTransitioning;
     }
-};
\ No newline at end of file
+
+    SceneId nextScene() const override {
+        return requestedScene;
+    }
+};
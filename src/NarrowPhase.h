@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include "BodyStore.h"
+#include "BroadPhase.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BIRDS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define BIRDS_TARGET(isa)
+#else
+#define BIRDS_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+// 窄相位批处理：宽相位给出候选对后，先成批计算中心距离的平方，
+// 只有足够近的球体对才交给 CollisionHandler 做开方和碰撞响应。
+// 各指令集版本只用乘法和加减法（不合并为 FMA），结果与标量版本逐位相同。
+
+// 可用的指令集
+enum class SimdLevel {
+    Scalar,                             // 标量（非 x86 平台只有这一种）
+    SSE2,                               // 每次 4 对
+    AVX2                                // 每次 8 对（gather 读取球体数据），只在显式指定时使用
+};
+
+class NarrowPhase {
+public:
+    // 当前 CPU 支持的最高指令集（只检测一次）
+    static SimdLevel supportedLevel() {
+        static const SimdLevel level = detectLevel();
+        return level;
+    }
+
+    // 物理世界默认使用的指令集：最高到 SSE2。AVX2 的 gather 在常见 CPU 上并不比 SSE2 逐个插入快，
+    // 实测有时还慢于标量版本，所以不自动选用（NarrowPhaseBench 可比较各版本）
+    static SimdLevel bestLevel() {
+        return supportedLevel() < SimdLevel::SSE2 ? supportedLevel() : SimdLevel::SSE2;
+    }
+
+    static const char* levelName(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::SSE2: return "SSE2";
+            case SimdLevel::AVX2: return "AVX2";
+            default: return "Scalar";
+        }
+    }
+
+    // 对 count 个球体对计算中心距离的平方写入 distanceSquared，
+    // 距离小于半径之和加 slop 的对在 near 中标记为 1
+    static void testPairs(const BodyStore& bodies, const BodyPair* pairs, std::size_t count, float slop,
+                          float* distanceSquared, std::uint8_t* near, SimdLevel level) {
+        std::size_t done = 0;
+#ifdef BIRDS_X86
+        if (level == SimdLevel::AVX2) {
+            done = testPairsAVX2(bodies, pairs, count, slop, distanceSquared, near);
+        } else if (level == SimdLevel::SSE2) {
+            done = testPairsSSE2(bodies, pairs, count, slop, distanceSquared, near);
+        }
+#endif
+        testPairsScalar(bodies, pairs + done, count - done, slop, distanceSquared + done, near + done);
+    }
+
+private:
+    static void testPairsScalar(const BodyStore& bodies, const BodyPair* pairs, std::size_t count, float slop,
+                                float* distanceSquared, std::uint8_t* near) {
+        const float* x = bodies.x.data();
+        const float* y = bodies.y.data();
+        const float* radius = bodies.radius.data();
+        for (std::size_t k = 0; k < count; ++k) {
+            const std::uint32_t a = pairs[k].a;
+            const std::uint32_t b = pairs[k].b;
+            const float dx = x[a] - x[b];
+            const float dy = y[a] - y[b];
+            const float squared = dx * dx + dy * dy;
+            const float reach = radius[a] + radius[b] + slop;
+            distanceSquared[k] = squared;
+            near[k] = squared < reach * reach;
+        }
+    }
+
+#ifdef BIRDS_X86
+    static SimdLevel detectLevel() {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        const int maxLeaf = info[0];
+        __cpuid(info, 1);
+        const bool sse2 = (info[3] & (1 << 26)) != 0;
+        // AVX2 还需要操作系统保存 YMM 寄存器（OSXSAVE + XCR0 的 SSE/AVX 位）
+        const bool osAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+        bool avx2 = false;
+        if (osAvx && maxLeaf >= 7) {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+#else
+        __builtin_cpu_init();
+        const bool sse2 = __builtin_cpu_supports("sse2");
+        const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+        if (avx2) return SimdLevel::AVX2;
+        if (sse2) return SimdLevel::SSE2;
+        return SimdLevel::Scalar;
+    }
+
+    // 每次处理 4 对，返回已处理的数量（余下的交给标量版本）
+    BIRDS_TARGET("sse2")
+    static std::size_t testPairsSSE2(const BodyStore& bodies, const BodyPair* pairs, std::size_t count, float slop,
+                                     float* distanceSquared, std::uint8_t* near) {
+        const float* x = bodies.x.data();
+        const float* y = bodies.y.data();
+        const float* radius = bodies.radius.data();
+        const __m128 slopVector = _mm_set1_ps(slop);
+
+        std::size_t k = 0;
+        for (; k + 4 <= count; k += 4) {
+            const BodyPair* p = pairs + k;
+            const __m128 ax = _mm_set_ps(x[p[3].a], x[p[2].a], x[p[1].a], x[p[0].a]);
+            const __m128 ay = _mm_set_ps(y[p[3].a], y[p[2].a], y[p[1].a], y[p[0].a]);
+            const __m128 ar = _mm_set_ps(radius[p[3].a], radius[p[2].a], radius[p[1].a], radius[p[0].a]);
+            const __m128 bx = _mm_set_ps(x[p[3].b], x[p[2].b], x[p[1].b], x[p[0].b]);
+            const __m128 by = _mm_set_ps(y[p[3].b], y[p[2].b], y[p[1].b], y[p[0].b]);
+            const __m128 br = _mm_set_ps(radius[p[3].b], radius[p[2].b], radius[p[1].b], radius[p[0].b]);
+
+            const __m128 dx = _mm_sub_ps(ax, bx);
+            const __m128 dy = _mm_sub_ps(ay, by);
+            const __m128 squared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            const __m128 reach = _mm_add_ps(_mm_add_ps(ar, br), slopVector);
+            const __m128i mask = _mm_castps_si128(_mm_cmplt_ps(squared, _mm_mul_ps(reach, reach)));
+
+            // 比较结果压缩成 4 个 0/1 字节一次写出
+            const __m128i bytes = _mm_packs_epi16(_mm_packs_epi32(mask, mask), _mm_setzero_si128());
+            const int packed = _mm_cvtsi128_si32(_mm_and_si128(bytes, _mm_set1_epi8(1)));
+            _mm_storeu_ps(distanceSquared + k, squared);
+            std::memcpy(near + k, &packed, 4);
+        }
+        return k;
+    }
+
+    // 每次处理 8 对：把交错存放的 (a, b) 下标拆成两个向量，再用 gather 读取球体数据
+    BIRDS_TARGET("avx2")
+    static std::size_t testPairsAVX2(const BodyStore& bodies, const BodyPair* pairs, std::size_t count, float slop,
+                                     float* distanceSquared, std::uint8_t* near) {
+        static_assert(sizeof(BodyPair) == 2 * sizeof(std::uint32_t), "BodyPair must be two packed indices");
+        const float* x = bodies.x.data();
+        const float* y = bodies.y.data();
+        const float* radius = bodies.radius.data();
+        const __m256 slopVector = _mm256_set1_ps(slop);
+
+        std::size_t k = 0;
+        for (; k + 8 <= count; k += 8) {
+            // lo = a0 b0 a1 b1 | a2 b2 a3 b3，hi = a4 b4 a5 b5 | a6 b6 a7 b7
+            const __m256 lo = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pairs + k)));
+            const __m256 hi = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pairs + k + 4)));
+            // 每个 128 位通道内取偶数 / 奇数位，再按 64 位重排成 0..7 的顺序
+            const __m256i ia = _mm256_permute4x64_epi64(
+                _mm256_castps_si256(_mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0));
+            const __m256i ib = _mm256_permute4x64_epi64(
+                _mm256_castps_si256(_mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0));
+
+            const __m256 dx = _mm256_sub_ps(_mm256_i32gather_ps(x, ia, 4), _mm256_i32gather_ps(x, ib, 4));
+            const __m256 dy = _mm256_sub_ps(_mm256_i32gather_ps(y, ia, 4), _mm256_i32gather_ps(y, ib, 4));
+            const __m256 squared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            const __m256 reach = _mm256_add_ps(
+                _mm256_add_ps(_mm256_i32gather_ps(radius, ia, 4), _mm256_i32gather_ps(radius, ib, 4)), slopVector);
+            const __m256i mask = _mm256_castps_si256(_mm256_cmp_ps(squared, _mm256_mul_ps(reach, reach), _CMP_LT_OQ));
+
+            // 比较结果压缩成 8 个 0/1 字节一次写出
+            const __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(mask), _mm256_extracti128_si256(mask, 1));
+            const __m128i bytes = _mm_and_si128(_mm_packs_epi16(words, words), _mm_set1_epi8(1));
+            _mm256_storeu_ps(distanceSquared + k, squared);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(near + k), bytes);
+        }
+        return k;
+    }
+#else
+    static SimdLevel detectLevel() {
+        return SimdLevel::Scalar;
+    }
+#endif
+};
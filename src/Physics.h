@@ -0,0 +1,1147 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include "BodyStore.h"
+#include "BroadPhase.h"
+#include "NarrowPhase.h"
+#include "JobSystem.h"
+#include "PhysicsEvents.h"
+#include "Random.h"
+
+// 物理核心：只依赖标准库，保存纯数据的物理状态，可在无显示环境下独立运行。
+// 渲染层（Game.h）每帧从这里同步一次精灵的位置和旋转。
+
+// 窗口相关常量
+constexpr int WINDOW_WIDTH = 1920;      // 游戏窗口宽度（像素）
+constexpr int WINDOW_HEIGHT = 1080;     // 游戏窗口高度（像素）
+
+// 游戏对象尺寸常量
+constexpr float PLAYER_RADIUS = 25.f;   // 玩家球体半径
+constexpr float ENEMY_RADIUS = 25.f;    // 敌方球体半径
+
+// 物理相关常量
+constexpr float REBOUND_COEFFICIENT = 0.8f;    // 碰撞后的反弹系数（0-1之间，1为完全弹性碰撞）
+constexpr float FRICTION_COEFFICIENT = 0.98f;   // 地面摩擦系数（每个 PHYSICS_DT 的速度衰减比例）
+constexpr float PHYSICS_DT = 0.1f;              // 基准物理步长
+constexpr float PHYSICS_DT_RATE = 60.f;         // 基准步长对应的频率：每秒 60 个 PHYSICS_DT
+constexpr float PHYSICS_STEP_RATE = 240.f;      // 游戏中固定步长模拟的频率（Hz）
+constexpr float STOP_VELOCITY = 0.01f;          // 速度分量都低于该值时视为停止
+constexpr float ROTATION_FACTOR = 0.5f;         // 速度换算为角速度的系数
+constexpr float SLEEP_CONTACT_SLOP = 1.f;       // 距离在半径之和加上该余量内视为静止接触
+constexpr float CCD_MOTION_THRESHOLD = 0.5f;    // 单步位移超过半径的该比例时做扫掠碰撞检测
+constexpr std::size_t PARALLEL_GRAIN = 1024;    // 并行时每块处理的球体（或球体对）数量
+
+// 停止预测：场上只剩慢速滑行的球时，按摩擦的等比衰减算出剩余行程，路径上不会碰到任何东西的球
+// 直接推进到停止（见 PhysicsWorld::settleQuietBodies）
+constexpr float SETTLE_DISTANCE = 1.f;          // 剩余行程不超过该值（像素）时预测，游戏中看不出跳动
+constexpr float SETTLE_HEADLESS_DISTANCE = 25.f; // 无显示的批量模拟使用的阈值
+constexpr std::size_t SETTLE_MAX_BODIES = 256;  // 球体更多时不做预测（逐对检查路径）
+constexpr float SETTLE_REACH_FACTOR = 2.f;      // 不能预测的滑行球可能被撞偏、撞快，按剩余行程的倍数留出余量
+
+// 场地边界（球体外接框越过边界时反弹）
+constexpr float ARENA_LEFT = 280.f;
+constexpr float ARENA_RIGHT = WINDOW_WIDTH - 300.f;
+constexpr float ARENA_TOP = 120.f;
+constexpr float ARENA_BOTTOM = static_cast<float>(WINDOW_HEIGHT);
+
+// 中心区域（目标区域）相关常量
+constexpr float CENTER_ZONE_X = 710.f;          // 中心区域左上角横坐标
+constexpr float CENTER_ZONE_Y = 290.f;          // 中心区域左上角纵坐标
+constexpr float CENTER_ZONE_WIDTH = 500.f;      // 中心区域宽度
+constexpr float CENTER_ZONE_HEIGHT = 500.f;     // 中心区域高度
+
+// 游戏机制相关常量
+constexpr int NUM_ENEMIES = 6;              // 场上敌方球体的数量
+constexpr float ENEMY_SPAWN_GAP = 50.f;     // 初始布局中敌方球体之间的最小间隙
+constexpr float CHARGE_MAX_TIME = 4.f;      // 最大蓄力时间（秒）
+constexpr float LAUNCH_MAX_SPEED = 250.f;   // 满蓄力时的发射速度
+
+// 特殊球效果相关常量
+constexpr float SPECIAL_EFFECT_RADIUS = 150.f;  // 推动效果的作用半径
+constexpr float SPECIAL_PUSH_FORCE = 100.f;     // 推动效果的最大冲量
+
+// 刚体：一个球体的全部物理状态（按值传递时使用，世界内部以 BodyStore 存放）
+struct Body {
+    // 运动状态
+    float x = 0.f, y = 0.f;             // 圆心位置
+    float vx = 0.f, vy = 0.f;           // 速度
+    float rotation = 0.f;               // 旋转角度（度，0-360）
+    float angularVelocity = 0.f;        // 角速度
+
+    // 形状和质量
+    float radius = 0.f;                 // 半径
+    float mass = 1.f;                   // 质量
+
+    // 状态标志
+    bool isStopped = true;              // 停止状态标志
+    bool isSpecial = false;             // 是否为特殊球
+    bool hasTriggeredSpecial = false;   // 是否已触发特殊效果
+    bool hasBeenLaunched = false;       // 是否已被发射
+
+    Body() = default;
+    Body(float px, float py, float r, float m = 1.f) : x(px), y(py), radius(r), mass(m) {}
+};
+
+// 碰撞处理器：处理球体之间以及球体与边界的碰撞
+class CollisionHandler {
+public:
+    // 球体 a、b 之间的碰撞，发生接触时返回 true；
+    // impactSpeed 为施加冲量前的法向接近速度，没有施加冲量时为 0
+    static bool applyCollision(BodyStore& bodies, std::size_t a, std::size_t b, float& impactSpeed) {
+        impactSpeed = 0.f;
+        // 先用距离的平方排除相离的球，只对可能接触的球开方
+        float dx = bodies.x[a] - bodies.x[b];
+        float dy = bodies.y[a] - bodies.y[b];
+        float distanceSquared = dx * dx + dy * dy;
+        float radiusSum = bodies.radius[a] + bodies.radius[b];
+        if (distanceSquared >= radiusSum * radiusSum) return false;
+
+        // 检查是否发生碰撞（两球中心距离是否小于半径之和）
+        float distance = std::sqrt(distanceSquared);
+        if (distance >= radiusSum) return false;
+
+        // 计算碰撞法线（单位向量），完全重合时取水平方向
+        float nx = 1.f, ny = 0.f;
+        if (distance > 0.f) {
+            nx = dx / distance;
+            ny = dy / distance;
+        }
+
+        // 如果物体正在分离，则不处理碰撞
+        if (!applyImpulse(bodies, a, b, nx, ny, impactSpeed)) return true;
+
+        // 防止球体重叠
+        float overlap = (radiusSum - distance) / 2.0f;
+        bodies.x[a] += nx * overlap;
+        bodies.y[a] += ny * overlap;
+        bodies.x[b] -= nx * overlap;
+        bodies.y[b] -= ny * overlap;
+        return true;
+    }
+
+    // 连续碰撞检测求得的接触时刻：两球刚好相切，只更新速度，返回法向接近速度
+    static float applyImpact(BodyStore& bodies, std::size_t a, std::size_t b) {
+        float dx = bodies.x[a] - bodies.x[b];
+        float dy = bodies.y[a] - bodies.y[b];
+        float distance = std::sqrt(dx * dx + dy * dy);
+        float nx = 1.f, ny = 0.f;
+        if (distance > 0.f) {
+            nx = dx / distance;
+            ny = dy / distance;
+        }
+        float impactSpeed = 0.f;
+        applyImpulse(bodies, a, b, nx, ny, impactSpeed);
+        return impactSpeed;
+    }
+
+    // 连续碰撞检测求得的撞墙时刻（wall: 左、右、上、下），
+    // 把球体贴住边界，并反转该方向上的速度
+    static void applyWallImpact(BodyStore& bodies, std::size_t i, int wall) {
+        const float r = bodies.radius[i];
+        switch (wall) {
+            case 0: bodies.x[i] = ARENA_LEFT + r; break;
+            case 1: bodies.x[i] = ARENA_RIGHT - r; break;
+            case 2: bodies.y[i] = ARENA_TOP + r; break;
+            default: bodies.y[i] = ARENA_BOTTOM - r; break;
+        }
+        std::vector<float>& v = wall < 2 ? bodies.vx : bodies.vy;
+        v[i] = -v[i] * REBOUND_COEFFICIENT;
+    }
+
+    // 所有球体的边界碰撞检测和处理
+    static void applyBoundaryCollisions(BodyStore& bodies) {
+        const std::size_t n = bodies.size();
+        float* x = bodies.x.data();
+        float* y = bodies.y.data();
+        float* vx = bodies.vx.data();
+        float* vy = bodies.vy.data();
+        const float* radius = bodies.radius.data();
+        const std::uint8_t* flags = bodies.flags.data();
+
+        for (std::size_t i = 0; i < n; ++i) {
+            if (flags[i] & BODY_SLEEPING) continue;
+            const float r = radius[i];
+
+            // 检测左右边界碰撞
+            if (x[i] - r < ARENA_LEFT || x[i] + r > ARENA_RIGHT) {
+                vx[i] = -vx[i] * REBOUND_COEFFICIENT;
+                x[i] = std::max(r, std::min(x[i], WINDOW_WIDTH - r));
+            }
+
+            // 检测上下边界碰撞
+            if (y[i] - r < ARENA_TOP || y[i] + r > ARENA_BOTTOM) {
+                vy[i] = -vy[i] * REBOUND_COEFFICIENT;
+                y[i] = std::max(r, std::min(y[i], WINDOW_HEIGHT - r));
+            }
+        }
+    }
+
+private:
+    // 沿法线 (nx, ny) 更新两球的速度和角速度，两球正在分离时返回 false
+    static bool applyImpulse(BodyStore& bodies, std::size_t a, std::size_t b, float nx, float ny,
+                             float& impactSpeed) {
+        // 计算相对速度
+        float avx = bodies.vx[a], avy = bodies.vy[a];
+        float bvx = bodies.vx[b], bvy = bodies.vy[b];
+        float rvx = avx - bvx;
+        float rvy = avy - bvy;
+        float velocityAlongNormal = rvx * nx + rvy * ny;
+
+        // 如果物体正在分离，则不处理碰撞
+        if (velocityAlongNormal > 0) return false;
+        impactSpeed = -velocityAlongNormal;
+
+        // 更新速度（基于动量守恒和能量守恒）
+        float newAvx = 0.5f * (avx + bvx + REBOUND_COEFFICIENT * (bvx - avx));
+        float newAvy = 0.5f * (avy + bvy + REBOUND_COEFFICIENT * (bvy - avy));
+        float newBvx = 0.5f * (bvx + avx + REBOUND_COEFFICIENT * (avx - bvx));
+        float newBvy = 0.5f * (bvy + avy + REBOUND_COEFFICIENT * (avy - bvy));
+        bodies.vx[a] = newAvx;
+        bodies.vy[a] = newAvy;
+        bodies.vx[b] = newBvx;
+        bodies.vy[b] = newBvy;
+
+        // 计算碰撞后的速度大小
+        float speedA = std::sqrt(newAvx * newAvx + newAvy * newAvy);
+        float speedB = std::sqrt(newBvx * newBvx + newBvy * newBvy);
+
+        // 根据碰撞点的相对位置决定旋转方向
+        float crossProduct = nx * rvy - ny * rvx;
+        bodies.angularVelocity[a] = -speedA * ROTATION_FACTOR * (crossProduct > 0 ? 1 : -1);
+        bodies.angularVelocity[b] = -speedB * ROTATION_FACTOR * (crossProduct > 0 ? -1 : 1);
+
+        // 设置运动状态
+        bodies.assign(a, BODY_STOPPED, false);
+        bodies.assign(b, BODY_STOPPED, false);
+        return true;
+    }
+};
+
+// 宽相位算法
+enum class BroadPhaseMode {
+    BruteForce,                         // 逐对检测所有球体
+    SpatialHash,                        // 空间哈希，只检测相邻格子中的球体
+    SweepAndPrune                       // 扫描裁剪，帧间增量维护包围盒重叠对
+};
+
+// 物理统计信息（每步更新）
+struct PhysicsStats {
+    std::size_t pairTests = 0;          // 本步做精确检测的球体对数
+    std::size_t contacts = 0;           // 本步发生接触的球体对数
+    std::size_t impacts = 0;            // 本步由连续碰撞检测处理的碰撞次数
+    std::size_t activeBodies = 0;       // 本步结束时未休眠的球体数
+    std::size_t sleepingBodies = 0;     // 本步结束时休眠的球体数
+    std::size_t settledBodies = 0;      // 本步由停止预测直接推进到停止的球体数
+};
+
+// 世界快照：影响后续模拟的全部状态。恢复后继续模拟与没有中断时逐位相同
+// （宽相位的候选对每步重建或按序排列，与历史无关，不需要保存）
+struct WorldSnapshot {
+    BodyStore bodies;                   // 所有球体（含上一步状态和休眠的接触岛）
+    std::size_t enemyCount = 0;         // 敌方球体数量
+    std::uint32_t nextIslandBase = 1;   // 下一批接触岛编号的起点
+};
+
+// 物理世界：持有所有球体的状态并推进模拟
+// 球体按 [敌方..., 玩家...] 的顺序连续存放在同一个 BodyStore 中
+class PhysicsWorld {
+public:
+    BodyStore bodies;                   // 所有球体（结构数组）
+    BroadPhaseMode broadPhase = BroadPhaseMode::SpatialHash;  // 宽相位算法
+    PhysicsStats stats;                 // 最近一步的统计信息
+    bool continuousCollision = true;    // 是否对高速球体做扫掠碰撞检测
+    SimdLevel narrowPhaseLevel = NarrowPhase::bestLevel();  // 窄相位批处理使用的指令集
+    JobSystem* jobs = nullptr;          // 可选的任务系统（不持有），为空时在当前线程执行
+    PhysicsEventStream events;          // 最近一步的碰撞、停止和特殊效果事件（积分开始时清空）
+    float settleDistance = SETTLE_DISTANCE;  // 停止预测的剩余行程阈值，0 表示关闭
+
+    // 清空所有球体
+    void clear() {
+        bodies.clear();
+        events.clear();
+        numEnemyBodies = 0;
+        nextIslandBase = 1;
+        sweepAndPrune.invalidate();
+    }
+
+    // 保存快照（复用 out 中数组已有的容量）
+    void saveSnapshot(WorldSnapshot& out) const {
+        out.bodies = bodies;
+        out.enemyCount = numEnemyBodies;
+        out.nextIslandBase = nextIslandBase;
+    }
+
+    // 恢复快照
+    void restoreSnapshot(const WorldSnapshot& snapshot) {
+        bodies = snapshot.bodies;
+        numEnemyBodies = snapshot.enemyCount;
+        nextIslandBase = snapshot.nextIslandBase;
+        events.clear();
+        events.reserve(bodies.size());
+        sweepAndPrune.invalidate();
+    }
+
+    // 添加球体，返回其在本组内的下标
+    std::size_t addEnemy(const Body& body) {
+        insertBody(numEnemyBodies, body);
+        return numEnemyBodies++;
+    }
+
+    std::size_t addPlayer(const Body& body) {
+        insertBody(bodies.size(), body);
+        return playerCount() - 1;
+    }
+
+    std::size_t enemyCount() const { return numEnemyBodies; }
+    std::size_t playerCount() const { return bodies.size() - numEnemyBodies; }
+
+    // 组内下标到存储下标的换算
+    std::size_t enemyIndex(std::size_t i) const { return i; }
+    std::size_t playerIndex(std::size_t i) const { return numEnemyBodies + i; }
+
+    // 以值的形式读写单个球体（存档和初始化使用，热路径直接访问 bodies）
+    Body getBody(std::size_t index) const {
+        Body body(bodies.x[index], bodies.y[index], bodies.radius[index], bodies.mass[index]);
+        body.vx = bodies.vx[index];
+        body.vy = bodies.vy[index];
+        body.rotation = bodies.rotation[index];
+        body.angularVelocity = bodies.angularVelocity[index];
+        body.isStopped = bodies.test(index, BODY_STOPPED);
+        body.isSpecial = bodies.test(index, BODY_SPECIAL);
+        body.hasTriggeredSpecial = bodies.test(index, BODY_TRIGGERED);
+        body.hasBeenLaunched = bodies.test(index, BODY_LAUNCHED);
+        return body;
+    }
+
+    void setBody(std::size_t index, const Body& body) {
+        bodies.x[index] = body.x;
+        bodies.y[index] = body.y;
+        bodies.vx[index] = body.vx;
+        bodies.vy[index] = body.vy;
+        bodies.rotation[index] = body.rotation;
+        bodies.angularVelocity[index] = body.angularVelocity;
+        bodies.radius[index] = body.radius;
+        bodies.mass[index] = body.mass;
+        bodies.flags[index] = packFlags(body);
+        resetHistory(index);
+    }
+
+    // 推进一步：先积分，再处理碰撞，返回本步的接触次数
+    int step(float dt) {
+        integrate(dt);
+        return resolveCollisions();
+    }
+
+    // 更新所有球体的位置、速度和旋转，并在特殊球停止时触发效果。
+    // 摩擦按步长折算，任意步长下每个 PHYSICS_DT 的衰减都是 FRICTION_COEFFICIENT
+    void integrate(float dt) {
+        if (dt != frictionDt) {
+            frictionDt = dt;
+            frictionPerStep = frictionFactor(dt);
+        }
+        const float friction = frictionPerStep;
+
+        const std::size_t n = bodies.size();
+        float* x = bodies.x.data();
+        float* y = bodies.y.data();
+        float* vx = bodies.vx.data();
+        float* vy = bodies.vy.data();
+        float* rotation = bodies.rotation.data();
+        float* angularVelocity = bodies.angularVelocity.data();
+        float* prevX = bodies.prevX.data();
+        float* prevY = bodies.prevY.data();
+        float* prevRotation = bodies.prevRotation.data();
+        std::uint8_t* flags = bodies.flags.data();
+
+        // 记录本步开始时的状态，并找出位移可能越过其他球体或边界的高速球
+        std::atomic<bool> anyFast{false};
+        forEachChunk(n, [&](std::size_t begin, std::size_t end) {
+            bool fast = false;
+            for (std::size_t i = begin; i < end; ++i) {
+                if (flags[i] & BODY_SLEEPING) continue;
+                prevX[i] = x[i];
+                prevY[i] = y[i];
+                prevRotation[i] = rotation[i];
+                if (continuousCollision && !(flags[i] & BODY_STOPPED)) {
+                    fast |= isFast(i, dt);
+                }
+            }
+            if (fast) anyFast.store(true, std::memory_order_relaxed);
+        });
+
+        // 有高速球时先把它们推进到碰撞时刻并处理碰撞，其余球整步推进
+        stats.impacts = 0;
+        events.clear();
+        const bool swept = continuousCollision && anyFast.load(std::memory_order_relaxed);
+        if (swept) {
+            sweepFastBodies(dt);
+        }
+
+        // 各球独立积分；停下的球先记下来，积分完成后再按下标顺序输出事件、触发特殊效果
+        stoppedNow.assign(n, STOPPED_NONE);
+        std::atomic<bool> anyStopped{false};
+        forEachChunk(n, [&](std::size_t begin, std::size_t end) {
+            bool stopped = false;
+            for (std::size_t i = begin; i < end; ++i) {
+                if (flags[i] & (BODY_SLEEPING | BODY_STOPPED)) continue;
+
+                flags[i] |= BODY_LAUNCHED;
+                if (!swept || !impactResolved[i]) {
+                    x[i] += vx[i] * dt;
+                    y[i] += vy[i] * dt;
+                }
+                const float nvx = vx[i] * friction;
+                const float nvy = vy[i] * friction;
+
+                // 更新旋转
+                const float speed = std::sqrt(nvx * nvx + nvy * nvy);
+                const float spin = -speed * ROTATION_FACTOR;
+                rotation[i] = wrapDegrees(rotation[i] + spin * dt);
+
+                // 检查停止条件
+                if (std::abs(nvx) >= STOP_VELOCITY || std::abs(nvy) >= STOP_VELOCITY) {
+                    vx[i] = nvx;
+                    vy[i] = nvy;
+                    angularVelocity[i] = spin;
+                    continue;
+                }
+                flags[i] |= BODY_STOPPED;
+                vx[i] = 0.f;
+                vy[i] = 0.f;
+                angularVelocity[i] = 0.f;
+                stoppedNow[i] = STOPPED_PLAIN;
+                stopped = true;
+
+                if (i >= numEnemyBodies && (flags[i] & (BODY_SPECIAL | BODY_TRIGGERED)) == BODY_SPECIAL) {
+                    flags[i] |= BODY_TRIGGERED;
+                    stoppedNow[i] = STOPPED_SPECIAL;
+                }
+            }
+            if (stopped) anyStopped.store(true, std::memory_order_relaxed);
+        });
+        if (!anyStopped.load(std::memory_order_relaxed)) return;
+
+        // 特殊球停下时触发推动效果
+        for (std::size_t i = 0; i < n; ++i) {
+            if (stoppedNow[i] == STOPPED_NONE) continue;
+            events.stop(static_cast<std::uint32_t>(i));
+            if (stoppedNow[i] == STOPPED_SPECIAL) {
+                const std::size_t pushed = triggerSpecialEffect(i);
+                events.specialTrigger(static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(pushed));
+            }
+        }
+    }
+
+    // 处理边界碰撞和球体之间的碰撞，返回接触次数
+    int resolveCollisions() {
+        stats.pairTests = 0;
+        stats.contacts = 0;
+
+        // 全部休眠时本步没有任何工作
+        const std::size_t n = bodies.size();
+        const std::size_t sleeping = static_cast<std::size_t>(
+            std::count_if(bodies.flags.begin(), bodies.flags.end(),
+                          [](std::uint8_t f) { return (f & BODY_SLEEPING) != 0; }));
+        if (sleeping == n) {
+            stats.activeBodies = 0;
+            stats.sleepingBodies = n;
+            return static_cast<int>(stats.impacts);
+        }
+
+        // 应用边界碰撞
+        CollisionHandler::applyBoundaryCollisions(bodies);
+
+        touchingPairs.clear();
+        switch (broadPhase) {
+            case BroadPhaseMode::BruteForce:
+                resolveAllPairs();
+                break;
+            case BroadPhaseMode::SpatialHash:
+                spatialHash.build(bodies);
+                gatherChunks(n, chunkPairs, candidatePairs, [&](std::size_t begin, std::size_t end,
+                                                                std::vector<BodyPair>& out) {
+                    spatialHash.findPairsInRange(bodies, begin, end, out, BODY_SLEEPING);
+                });
+                std::sort(candidatePairs.begin(), candidatePairs.end());
+                resolvePairs(candidatePairs);
+                break;
+            case BroadPhaseMode::SweepAndPrune:
+                sweepAndPrune.update(bodies);
+                resolvePairs(sweepAndPrune.pairs());
+                break;
+        }
+
+        stats.settledBodies = settleDistance > 0.f ? settleQuietBodies() : 0;
+        updateSleep();
+        return static_cast<int>(stats.contacts + stats.impacts);
+    }
+
+    // 停止预测。没有碰撞时每步 x += v * dt、v *= f，剩余行程为 |v| * dt * (1 + f + f^2 + ...)，
+    // 不超过 |v| * dt / (1 - f)。只在所有运动中的球的这个上界都不超过 settleDistance、
+    // 且没有待触发的特殊球时进行：从当前位置沿速度方向走完上界的路径留在场内、
+    // 与静止的球和其他滑行球（按 SETTLE_REACH_FACTOR 倍行程留余量）都不接触的球，
+    // 用与 integrate 相同的运算逐步推进到停止（只是一个标量循环，不做碰撞检测），
+    // 结果与继续完整模拟逐位相同。返回被推进到停止的球体数
+    std::size_t settleQuietBodies() {
+        const std::size_t n = bodies.size();
+        if (n > SETTLE_MAX_BODIES) return 0;
+
+        const float dt = frictionDt;
+        const float friction = frictionPerStep;
+        const float travelPerSpeed = dt / (1.f - friction);
+
+        settleTravel.assign(n, 0.f);
+        bool anyMoving = false;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (bodies.flags[i] & (BODY_SLEEPING | BODY_STOPPED)) continue;
+            if ((bodies.flags[i] & (BODY_SPECIAL | BODY_TRIGGERED)) == BODY_SPECIAL) return 0;
+            const float travel = std::sqrt(bodies.vx[i] * bodies.vx[i] + bodies.vy[i] * bodies.vy[i]) * travelPerSpeed;
+            if (travel > settleDistance) return 0;
+            settleTravel[i] = travel;
+            anyMoving = true;
+        }
+        if (!anyMoving) return 0;
+
+        // 先判断再推进：所有判断都基于本步的状态，与下标顺序无关
+        settleClear.assign(n, 0);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (bodies.flags[i] & (BODY_SLEEPING | BODY_STOPPED)) continue;
+            settleClear[i] = pathIsClear(i);
+        }
+
+        std::size_t settled = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!settleClear[i]) continue;
+            settleBody(i, dt, friction);
+            events.stop(static_cast<std::uint32_t>(i));
+            settled++;
+        }
+        return settled;
+    }
+
+    // 特殊效果：以特殊球为中心向外推动附近的球体，返回被推动的球体数
+    std::size_t triggerSpecialEffect(std::size_t source) {
+        const std::size_t n = bodies.size();
+        std::size_t pushed = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (i != source) {
+                pushed += applyPush(source, i);
+            }
+        }
+        return pushed;
+    }
+
+    // 朝目标点发射玩家球，速度与蓄力时间成正比
+    void launchPlayer(std::size_t index, float targetX, float targetY, float chargeTime) {
+        if (index >= playerCount()) return;
+
+        std::size_t i = playerIndex(index);
+        float dirX = targetX - bodies.x[i];
+        float dirY = targetY - bodies.y[i];
+        float length = std::sqrt(dirX * dirX + dirY * dirY);
+        if (length > 0) {
+            dirX /= length;
+            dirY /= length;
+        }
+
+        float speed = std::min(chargeTime, CHARGE_MAX_TIME) / CHARGE_MAX_TIME * LAUNCH_MAX_SPEED;
+        wake(i);
+        bodies.vx[i] = dirX * speed;
+        bodies.vy[i] = dirY * speed;
+        bodies.assign(i, BODY_STOPPED, false);
+    }
+
+    // 唤醒球体及其所在的整个接触岛
+    void wake(std::size_t index) {
+        if (!(bodies.flags[index] & BODY_SLEEPING)) return;
+
+        const std::uint32_t id = bodies.island[index];
+        const std::size_t n = bodies.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            if ((bodies.flags[i] & BODY_SLEEPING) && bodies.island[i] == id) {
+                bodies.flags[i] &= static_cast<std::uint8_t>(~BODY_SLEEPING);
+                resetHistory(i);
+            }
+        }
+    }
+
+    // 按种子在中心区域内随机放置 count 个敌方球体：球体完整落在区域内，彼此至少相隔 ENEMY_SPAWN_GAP。
+    // 同一种子总是得到相同的布局；返回实际放置的数量（区域放不下时可能少于 count）
+    int spawnEnemies(std::uint64_t seed, int count = NUM_ENEMIES) {
+        SimRandom random(seed);
+        const float minDistance = ENEMY_RADIUS * 2 + ENEMY_SPAWN_GAP;
+        const int maxAttempts = 10000 * count;
+
+        int placed = 0;
+        for (int attempt = 0; placed < count && attempt < maxAttempts; ++attempt) {
+            // 在区域内取整数坐标，越过区域边界的位置重新抽取
+            const float x = CENTER_ZONE_X + static_cast<float>(random.below(static_cast<std::uint32_t>(CENTER_ZONE_WIDTH)));
+            const float y = CENTER_ZONE_Y + static_cast<float>(random.below(static_cast<std::uint32_t>(CENTER_ZONE_HEIGHT)));
+            if (x - ENEMY_RADIUS < CENTER_ZONE_X || x + ENEMY_RADIUS > CENTER_ZONE_X + CENTER_ZONE_WIDTH ||
+                y - ENEMY_RADIUS < CENTER_ZONE_Y || y + ENEMY_RADIUS > CENTER_ZONE_Y + CENTER_ZONE_HEIGHT) {
+                continue;
+            }
+
+            // 检查与其他敌方球体的距离
+            bool valid = true;
+            for (std::size_t j = 0; j < numEnemyBodies && valid; ++j) {
+                const float dx = x - bodies.x[j];
+                const float dy = y - bodies.y[j];
+                valid = dx * dx + dy * dy >= minDistance * minDistance;
+            }
+            if (!valid) continue;
+
+            addEnemy(Body(x, y, ENEMY_RADIUS));
+            placed++;
+        }
+        return placed;
+    }
+
+    // 放置本局的四个玩家球体（场地下方一字排开，第 3、4 个为特殊球，停止时触发推动效果）
+    void spawnPlayers() {
+        Body players[] = {
+            Body(WINDOW_WIDTH / 2 - 170, WINDOW_HEIGHT - 170, PLAYER_RADIUS),
+            Body(WINDOW_WIDTH / 2 - 70, WINDOW_HEIGHT - 170, PLAYER_RADIUS),
+            Body(WINDOW_WIDTH / 2 + 30, WINDOW_HEIGHT - 170, PLAYER_RADIUS, 1.0f),
+            Body(WINDOW_WIDTH / 2 + 130, WINDOW_HEIGHT - 170, PLAYER_RADIUS, 1.0f)
+        };
+        players[2].isSpecial = true;
+        players[3].isSpecial = true;
+
+        for (const Body& player : players) {
+            addPlayer(player);
+        }
+    }
+
+    // 当前状态的哈希（FNV-1a，按比特位计算位置、速度、旋转和标志）。
+    // 相同的种子和输入在每一步都得到相同的值，可用于复现和比对模拟结果
+    std::uint64_t stateHash() const {
+        std::uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](const void* data, std::size_t size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t k = 0; k < size; ++k) {
+                hash = (hash ^ bytes[k]) * 1099511628211ull;
+            }
+        };
+
+        const std::uint64_t counts[2] = {numEnemyBodies, bodies.size()};
+        mix(counts, sizeof(counts));
+        const std::size_t bytes = bodies.size() * sizeof(float);
+        mix(bodies.x.data(), bytes);
+        mix(bodies.y.data(), bytes);
+        mix(bodies.vx.data(), bytes);
+        mix(bodies.vy.data(), bytes);
+        mix(bodies.rotation.data(), bytes);
+        mix(bodies.angularVelocity.data(), bytes);
+        mix(bodies.flags.data(), bodies.size());
+        return hash;
+    }
+
+    // 各组球体是否都已停止
+    bool enemiesStopped() const { return rangeStopped(0, numEnemyBodies); }
+    bool playersStopped() const { return rangeStopped(numEnemyBodies, bodies.size()); }
+    bool allStopped() const { return rangeStopped(0, bodies.size()); }
+
+    // 是否有已发射但尚未触发效果的特殊球
+    bool hasPendingSpecial() const {
+        for (std::size_t i = numEnemyBodies; i < bodies.size(); ++i) {
+            if ((bodies.flags[i] & (BODY_SPECIAL | BODY_LAUNCHED | BODY_TRIGGERED)) ==
+                (BODY_SPECIAL | BODY_LAUNCHED)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 统计完全离开中心区域的敌方球体数量（即得分）
+    int countEnemiesOutsideZone() const {
+        int count = 0;
+        for (std::size_t i = 0; i < numEnemyBodies; ++i) {
+            const float x = bodies.x[i], y = bodies.y[i], r = bodies.radius[i];
+            if (x + r <= CENTER_ZONE_X ||                       // 左侧完全在中心区域外
+                x - r >= CENTER_ZONE_X + CENTER_ZONE_WIDTH ||   // 右侧完全在中心区域外
+                y + r <= CENTER_ZONE_Y ||                       // 上侧完全在中心区域外
+                y - r >= CENTER_ZONE_Y + CENTER_ZONE_HEIGHT) {  // 下侧完全在中心区域外
+                count++;
+            }
+        }
+        return count;
+    }
+
+private:
+    std::size_t numEnemyBodies = 0;     // 敌方球体数量（存储中的前 numEnemyBodies 个）
+    float frictionDt = PHYSICS_DT;                  // frictionPerStep 对应的步长
+    float frictionPerStep = FRICTION_COEFFICIENT;   // 当前步长下每步的速度衰减比例
+    std::vector<std::uint8_t> stoppedNow;           // 本步停下的球体（StoppedKind）
+
+    // 球体在本步停下的方式
+    enum StoppedKind : std::uint8_t {
+        STOPPED_NONE,                   // 没有停下
+        STOPPED_PLAIN,                  // 停下
+        STOPPED_SPECIAL                 // 停下并需要触发特殊效果
+    };
+
+    // 按 PARALLEL_GRAIN 分块执行 fn(起点, 终点)：有任务系统时各块并行，否则在当前线程一次执行
+    template <typename Fn>
+    void forEachChunk(std::size_t count, Fn&& fn) {
+        if (jobs) {
+            jobs->parallelFor(0, count, PARALLEL_GRAIN, fn);
+        } else {
+            fn(0, count);
+        }
+    }
+
+    // 分块收集结果，再按块的顺序合并到 out，合并结果与线程数无关
+    template <typename T, typename Fn>
+    void gatherChunks(std::size_t count, std::vector<std::vector<T>>& parts, std::vector<T>& out, Fn&& fn) {
+        const std::size_t chunks = jobs ? (count + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN : 1;
+        parts.resize(std::max<std::size_t>(chunks, 1));
+        for (std::vector<T>& part : parts) {
+            part.clear();
+        }
+        forEachChunk(count, [&](std::size_t begin, std::size_t end) {
+            fn(begin, end, parts[jobs ? begin / PARALLEL_GRAIN : 0]);
+        });
+
+        out.clear();
+        for (const std::vector<T>& part : parts) {
+            out.insert(out.end(), part.begin(), part.end());
+        }
+    }
+
+    // 把上一步的状态设为当前状态（瞬移或休眠后不再插值）
+    void resetHistory(std::size_t i) {
+        bodies.prevX[i] = bodies.x[i];
+        bodies.prevY[i] = bodies.y[i];
+        bodies.prevRotation[i] = bodies.rotation[i];
+    }
+
+    // 宽相位
+    SpatialHash spatialHash;                // 空间哈希
+    std::vector<BodyPair> candidatePairs;   // 空间哈希给出的候选球体对
+    std::vector<std::vector<BodyPair>> chunkPairs;  // 分块收集的候选球体对
+    SweepAndPrune sweepAndPrune;            // 增量扫描裁剪
+
+    // 窄相位批处理
+    std::vector<float> pairDistanceSquared;   // 每个候选对中心距离的平方
+    std::vector<std::uint8_t> pairNear;       // 候选对是否在接触距离内
+    std::vector<std::uint8_t> pairMoved;      // 本轮检测中被碰撞推开过的球
+
+    // 连续碰撞检测找到的最早碰撞
+    struct Impact {
+        float time = 2.f;                   // 碰撞时刻占本步步长的比例，大于 1 表示没有碰撞
+        std::size_t mover = 0;              // 高速球
+        std::size_t other = SIZE_MAX;       // 被撞的球，撞墙时为 SIZE_MAX
+        int wall = 0;                       // 撞墙时的边界（0-3: 左、右、上、下）
+
+        // 按时间先后排序，同时刻按下标，保证结果与遍历顺序无关
+        bool operator<(const Impact& other) const {
+            if (time != other.time) return time < other.time;
+            return mover != other.mover ? mover < other.mover : this->other < other.other;
+        }
+    };
+
+    std::vector<Impact> impacts;            // 本步高速球的第一次碰撞
+    std::vector<std::vector<Impact>> chunkImpacts;  // 分块收集的碰撞
+    std::vector<std::uint8_t> impactResolved;  // 本步已按碰撞时刻推进过的球
+
+    // 休眠
+    std::vector<BodyPair> touchingPairs;    // 本步处于接触状态的球体对（接触岛的边）
+    std::vector<std::uint32_t> islandParent;  // 并查集
+    std::vector<std::uint8_t> islandStopped;  // 每个接触岛是否整体静止
+    std::uint32_t nextIslandBase = 1;       // 下一批接触岛编号的起点
+
+    // 停止预测
+    std::vector<float> settleTravel;        // 运动中的球剩余行程的上界
+    std::vector<std::uint8_t> settleClear;  // 路径上没有障碍、可以直接推进到停止的球
+
+    // 检测单个球体对并更新统计，发生接触时返回 true
+    bool testPair(std::size_t a, std::size_t b) {
+        const bool sleepA = bodies.flags[a] & BODY_SLEEPING;
+        const bool sleepB = bodies.flags[b] & BODY_SLEEPING;
+        if (sleepA && sleepB) return false;
+
+        // 休眠的球只在运动球的扫掠包围盒碰到它时才被唤醒
+        if (sleepA || sleepB) {
+            const std::size_t sleeper = sleepA ? a : b;
+            if (!sweptBoundsTouch(sleepA ? b : a, sleeper)) return false;
+            wake(sleeper);
+        }
+
+        stats.pairTests++;
+        float impactSpeed = 0.f;
+        const bool contact = CollisionHandler::applyCollision(bodies, a, b, impactSpeed);
+        stats.contacts += contact;
+        if (impactSpeed > 0.f) {
+            events.contact(static_cast<std::uint32_t>(a), static_cast<std::uint32_t>(b), impactSpeed);
+        }
+
+        // 记录接触（含刚好贴在一起的静止接触），用于划分接触岛
+        const float dx = bodies.x[a] - bodies.x[b];
+        const float dy = bodies.y[a] - bodies.y[b];
+        const float reach = bodies.radius[a] + bodies.radius[b] + SLEEP_CONTACT_SLOP;
+        if (contact || dx * dx + dy * dy < reach * reach) {
+            touchingPairs.push_back({static_cast<std::uint32_t>(a), static_cast<std::uint32_t>(b)});
+        }
+        return contact;
+    }
+
+    // 点 (px, py) 到线段 (ax, ay)-(bx, by) 距离的平方
+    static float segmentDistanceSquared(float px, float py, float ax, float ay, float bx, float by) {
+        const float dx = bx - ax;
+        const float dy = by - ay;
+        const float lengthSquared = dx * dx + dy * dy;
+        float t = lengthSquared > 0.f ? ((px - ax) * dx + (py - ay) * dy) / lengthSquared : 0.f;
+        t = std::clamp(t, 0.f, 1.f);
+        const float ex = ax + dx * t - px;
+        const float ey = ay + dy * t - py;
+        return ex * ex + ey * ey;
+    }
+
+    // 球 i 沿速度方向走完剩余行程的路径是否留在场内、不接触其他球
+    bool pathIsClear(std::size_t i) const {
+        const float x = bodies.x[i];
+        const float y = bodies.y[i];
+        const float r = bodies.radius[i];
+        const float speed = std::sqrt(bodies.vx[i] * bodies.vx[i] + bodies.vy[i] * bodies.vy[i]);
+        const float endX = x + bodies.vx[i] / speed * settleTravel[i];
+        const float endY = y + bodies.vy[i] / speed * settleTravel[i];
+
+        // 场地是矩形，两个端点都在场内时整条路径都在场内（与 applyBoundaryCollisions 的判断相同）
+        for (const float px : {x, endX}) {
+            if (px - r < ARENA_LEFT || px + r > ARENA_RIGHT) return false;
+        }
+        for (const float py : {y, endY}) {
+            if (py - r < ARENA_TOP || py + r > ARENA_BOTTOM) return false;
+        }
+
+        for (std::size_t j = 0; j < bodies.size(); ++j) {
+            if (j == i) continue;
+            const float reach = r + bodies.radius[j] + SLEEP_CONTACT_SLOP + settleTravel[j] * SETTLE_REACH_FACTOR;
+            if (segmentDistanceSquared(bodies.x[j], bodies.y[j], x, y, endX, endY) < reach * reach) return false;
+        }
+        return true;
+    }
+
+    // 与 integrate 中单个球的运算相同，逐步推进到停止
+    void settleBody(std::size_t i, float dt, float friction) {
+        float px = bodies.x[i], py = bodies.y[i];
+        float vx = bodies.vx[i], vy = bodies.vy[i];
+        float rotation = bodies.rotation[i];
+        for (;;) {
+            px += vx * dt;
+            py += vy * dt;
+            const float nvx = vx * friction;
+            const float nvy = vy * friction;
+            const float speed = std::sqrt(nvx * nvx + nvy * nvy);
+            rotation = wrapDegrees(rotation + -speed * ROTATION_FACTOR * dt);
+            if (std::abs(nvx) < STOP_VELOCITY && std::abs(nvy) < STOP_VELOCITY) break;
+            vx = nvx;
+            vy = nvy;
+        }
+        bodies.x[i] = px;
+        bodies.y[i] = py;
+        bodies.rotation[i] = rotation;
+        bodies.vx[i] = 0.f;
+        bodies.vy[i] = 0.f;
+        bodies.angularVelocity[i] = 0.f;
+        bodies.flags[i] |= BODY_STOPPED | BODY_LAUNCHED;
+    }
+
+    // 运动球 mover 本步的扫掠包围盒是否碰到球 target 的包围盒
+    bool sweptBoundsTouch(std::size_t mover, std::size_t target) const {
+        const float r = bodies.radius[mover] + bodies.radius[target] + SLEEP_CONTACT_SLOP;
+        const float minX = std::min(bodies.prevX[mover], bodies.x[mover]) - r;
+        const float maxX = std::max(bodies.prevX[mover], bodies.x[mover]) + r;
+        const float minY = std::min(bodies.prevY[mover], bodies.y[mover]) - r;
+        const float maxY = std::max(bodies.prevY[mover], bodies.y[mover]) + r;
+        return bodies.x[target] >= minX && bodies.x[target] <= maxX &&
+               bodies.y[target] >= minY && bodies.y[target] <= maxY;
+    }
+
+    // 本步位移是否超过 CCD_MOTION_THRESHOLD 倍半径
+    bool isFast(std::size_t i, float dt) const {
+        const float reach = bodies.radius[i] * CCD_MOTION_THRESHOLD;
+        const float speedSquared = bodies.vx[i] * bodies.vx[i] + bodies.vy[i] * bodies.vy[i];
+        return speedSquared * dt * dt > reach * reach;
+    }
+
+    // 单个球按当前速度推进 dt
+    void advanceBody(std::size_t i, float dt) {
+        bodies.x[i] += bodies.vx[i] * dt;
+        bodies.y[i] += bodies.vy[i] * dt;
+    }
+
+    // 扫掠碰撞：每个高速球推进到自己的第一次碰撞，处理后用新速度走完剩余步长。
+    // 碰撞按时间先后处理，轨迹已被更早碰撞改变的球不再重复处理（留给离散检测）
+    void sweepFastBodies(float dt) {
+        collectImpacts(dt);
+        std::sort(impacts.begin(), impacts.end());
+        impactResolved.assign(bodies.size(), 0);
+
+        for (const Impact& impact : impacts) {
+            const std::size_t a = impact.mover;
+            const std::size_t b = impact.other;
+            const bool hitsWall = b == SIZE_MAX;
+            if (impactResolved[a] || (!hitsWall && impactResolved[b])) continue;
+
+            const float before = dt * impact.time;
+            const float after = dt - before;
+            if (hitsWall) {
+                advanceBody(a, before);
+                CollisionHandler::applyWallImpact(bodies, a, impact.wall);
+                advanceBody(a, after);
+            } else {
+                wake(b);
+                advanceBody(a, before);
+                advanceBody(b, before);
+                const float impactSpeed = CollisionHandler::applyImpact(bodies, a, b);
+                if (impactSpeed > 0.f) {
+                    events.contact(static_cast<std::uint32_t>(a), static_cast<std::uint32_t>(b), impactSpeed);
+                }
+                advanceBody(a, after);
+                advanceBody(b, after);
+                impactResolved[b] = 1;
+            }
+            impactResolved[a] = 1;
+            stats.impacts++;
+        }
+    }
+
+    // 求出每个高速球在 dt 内最早的碰撞（相对运动视为匀速直线），各球之间互不影响，可分块并行
+    void collectImpacts(float dt) {
+        const std::size_t n = bodies.size();
+
+        // 两个高速球可能相向而行，查询范围要加上最大的单步位移
+        float maxTravel = 0.f;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (bodies.flags[i] & (BODY_SLEEPING | BODY_STOPPED)) continue;
+            if (!isFast(i, dt)) continue;
+            maxTravel = std::max(maxTravel, std::sqrt(bodies.vx[i] * bodies.vx[i] + bodies.vy[i] * bodies.vy[i]) * dt);
+        }
+        spatialHash.build(bodies);
+        const float margin = spatialHash.getCellSize() + maxTravel;
+
+        gatherChunks(n, chunkImpacts, impacts, [&](std::size_t begin, std::size_t end, std::vector<Impact>& out) {
+            for (std::size_t i = begin; i < end; ++i) {
+                if (bodies.flags[i] & (BODY_SLEEPING | BODY_STOPPED)) continue;
+                if (!isFast(i, dt)) continue;
+
+                const float x = bodies.x[i];
+                const float y = bodies.y[i];
+                const float dx = bodies.vx[i] * dt;
+                const float dy = bodies.vy[i] * dt;
+                const float r = bodies.radius[i];
+                const float reach = r + margin;
+                Impact earliest;
+
+                // 球体之间：按相对位移 d 求 |p + d * t| = rA + rB 的最小根（静止的球速度为 0）
+                spatialHash.forEachInBox(std::min(x, x + dx) - reach, std::min(y, y + dy) - reach,
+                                         std::max(x, x + dx) + reach, std::max(y, y + dy) + reach,
+                                         [&](std::size_t j) {
+                    if (j == i) return;
+                    const float px = x - bodies.x[j];
+                    const float py = y - bodies.y[j];
+                    const float rx = dx - bodies.vx[j] * dt;
+                    const float ry = dy - bodies.vy[j] * dt;
+                    const float radiusSum = r + bodies.radius[j];
+
+                    const float c = px * px + py * py - radiusSum * radiusSum;
+                    const float b = px * rx + py * ry;
+                    if (c <= 0.f || b >= 0.f) return;       // 已经重叠（交给离散检测）或正在远离
+                    const float a = rx * rx + ry * ry;
+                    const float discriminant = b * b - a * c;
+                    if (discriminant < 0.f) return;
+                    const float t = (-b - std::sqrt(discriminant)) / a;
+                    if (t >= 0.f && t < earliest.time) {
+                        earliest = {t, i, j, 0};
+                    }
+                });
+
+                // 场地边界：只处理当前仍在场内、正朝边界运动的球
+                const float wallTimes[4] = {
+                    dx < 0.f && x - r >= ARENA_LEFT ? (ARENA_LEFT + r - x) / dx : 2.f,
+                    dx > 0.f && x + r <= ARENA_RIGHT ? (ARENA_RIGHT - r - x) / dx : 2.f,
+                    dy < 0.f && y - r >= ARENA_TOP ? (ARENA_TOP + r - y) / dy : 2.f,
+                    dy > 0.f && y + r <= ARENA_BOTTOM ? (ARENA_BOTTOM - r - y) / dy : 2.f,
+                };
+                for (int wall = 0; wall < 4; ++wall) {
+                    if (wallTimes[wall] < earliest.time) {
+                        earliest = {wallTimes[wall], i, SIZE_MAX, wall};
+                    }
+                }
+
+                if (earliest.time <= 1.f) {
+                    out.push_back(earliest);
+                }
+            }
+        });
+    }
+
+    std::uint32_t findIsland(std::uint32_t i) {
+        while (islandParent[i] != i) {
+            islandParent[i] = islandParent[islandParent[i]];
+            i = islandParent[i];
+        }
+        return i;
+    }
+
+    // 按本步的接触关系划分接触岛，整体静止的岛进入休眠
+    void updateSleep() {
+        const std::size_t n = bodies.size();
+        islandParent.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            islandParent[i] = static_cast<std::uint32_t>(i);
+        }
+        for (const BodyPair& pair : touchingPairs) {
+            islandParent[findIsland(pair.a)] = findIsland(pair.b);
+        }
+
+        islandStopped.assign(n, 1);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!(bodies.flags[i] & BODY_SLEEPING) && !(bodies.flags[i] & BODY_STOPPED)) {
+                islandStopped[findIsland(static_cast<std::uint32_t>(i))] = 0;
+            }
+        }
+
+        std::size_t sleeping = 0;
+        bool anyFellAsleep = false;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!(bodies.flags[i] & BODY_SLEEPING)) {
+                const std::uint32_t root = findIsland(static_cast<std::uint32_t>(i));
+                if (!islandStopped[root]) continue;
+                bodies.flags[i] |= BODY_SLEEPING;
+                bodies.island[i] = nextIslandBase + root;
+                resetHistory(i);
+                anyFellAsleep = true;
+            }
+            sleeping++;
+        }
+        if (anyFellAsleep) {
+            nextIslandBase += static_cast<std::uint32_t>(n);
+        }
+
+        stats.sleepingBodies = sleeping;
+        stats.activeBodies = n - sleeping;
+    }
+
+    // 对宽相位给出的候选对做精确检测：先（并行）批量比较距离的平方，
+    // 再按候选对的顺序在当前线程逐对处理足够近的球，碰撞冲量的施加顺序与线程数无关。
+    // 前面的碰撞推开过的球位置已变，涉及休眠球的对可能需要唤醒，这两类仍逐对检测，
+    // 结果与逐对顺序检测完全相同
+    void resolvePairs(const std::vector<BodyPair>& pairs) {
+        const std::size_t count = pairs.size();
+        pairDistanceSquared.resize(count);
+        pairNear.resize(count);
+        forEachChunk(count, [&](std::size_t begin, std::size_t end) {
+            NarrowPhase::testPairs(bodies, pairs.data() + begin, end - begin, SLEEP_CONTACT_SLOP,
+                                   pairDistanceSquared.data() + begin, pairNear.data() + begin, narrowPhaseLevel);
+        });
+
+        pairMoved.assign(bodies.size(), 0);
+        for (std::size_t k = 0; k < count; ++k) {
+            const std::uint32_t a = pairs[k].a;
+            const std::uint32_t b = pairs[k].b;
+            if (!pairNear[k] && !pairMoved[a] && !pairMoved[b] &&
+                !((bodies.flags[a] | bodies.flags[b]) & BODY_SLEEPING)) {
+                continue;
+            }
+            if (testPair(a, b)) {
+                pairMoved[a] = 1;
+                pairMoved[b] = 1;
+            }
+        }
+    }
+
+    // 逐对检测：玩家与敌人、玩家之间、敌人之间
+    void resolveAllPairs() {
+        const std::size_t n = bodies.size();
+
+        // 检测玩家与敌人之间的碰撞
+        for (std::size_t i = numEnemyBodies; i < n; ++i) {
+            for (std::size_t j = 0; j < numEnemyBodies; ++j) {
+                testPair(i, j);
+            }
+        }
+
+        // 检测玩家之间的碰撞
+        for (std::size_t i = numEnemyBodies; i < n; ++i) {
+            for (std::size_t j = i + 1; j < n; ++j) {
+                testPair(i, j);
+            }
+        }
+
+        // 检测敌人之间的碰撞
+        for (std::size_t i = 0; i < numEnemyBodies; ++i) {
+            for (std::size_t j = i + 1; j < numEnemyBodies; ++j) {
+                testPair(i, j);
+            }
+        }
+    }
+
+    static std::uint8_t packFlags(const Body& body) {
+        return static_cast<std::uint8_t>((body.isStopped ? BODY_STOPPED : 0) |
+                                         (body.isSpecial ? BODY_SPECIAL : 0) |
+                                         (body.hasTriggeredSpecial ? BODY_TRIGGERED : 0) |
+                                         (body.hasBeenLaunched ? BODY_LAUNCHED : 0));
+    }
+
+    void insertBody(std::size_t index, const Body& body) {
+        bodies.insert(index, body.x, body.y, body.radius, body.mass, packFlags(body));
+        setBody(index, body);
+        events.reserve(bodies.size());
+    }
+
+    bool rangeStopped(std::size_t begin, std::size_t end) const {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (!(bodies.flags[i] & BODY_STOPPED)) return false;
+        }
+        return true;
+    }
+
+    // 步长 dt 对应的摩擦衰减 FRICTION_COEFFICIENT^(dt / PHYSICS_DT)。
+    // 步长为 PHYSICS_DT / 2^k 时（游戏中为 1/4）用连续开方求得：开方是精确舍入的运算，
+    // 结果与平台和数学库无关；其他步长才使用 std::pow
+    static float frictionFactor(float dt) {
+        if (dt == PHYSICS_DT) return FRICTION_COEFFICIENT;
+
+        const double ratio = static_cast<double>(dt) / PHYSICS_DT;
+        double factor = FRICTION_COEFFICIENT;
+        double power = 1.0;
+        for (int k = 1; k <= 10; ++k) {
+            factor = std::sqrt(factor);
+            power *= 0.5;
+            if (std::abs(ratio - power) <= power * 1e-6) {
+                return static_cast<float>(factor);
+            }
+        }
+        return static_cast<float>(std::pow(static_cast<double>(FRICTION_COEFFICIENT), ratio));
+    }
+
+    // 把角度归一化到 [0, 360)；每步转角远小于一圈，与 fmod 结果逐位相同
+    static float wrapDegrees(float degrees) {
+        if (degrees >= 360.f) return degrees - 360.f;
+        if (degrees < 0.f) return degrees + 360.f;
+        return degrees;
+    }
+
+    // 对单个球体施加径向推力，目标在作用范围内时返回 true
+    bool applyPush(std::size_t source, std::size_t target) {
+        float dx = bodies.x[target] - bodies.x[source];
+        float dy = bodies.y[target] - bodies.y[source];
+        float distance = std::sqrt(dx * dx + dy * dy);
+
+        if (distance < SPECIAL_EFFECT_RADIUS && distance > 0) {
+            float forceMagnitude = SPECIAL_PUSH_FORCE * (1.0f - distance / SPECIAL_EFFECT_RADIUS);
+            wake(target);
+            bodies.vx[target] += dx / distance * forceMagnitude;
+            bodies.vy[target] += dy / distance * forceMagnitude;
+            bodies.assign(target, BODY_STOPPED, false);
+            return true;
+        }
+        return false;
+    }
+};
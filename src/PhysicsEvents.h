@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// 物理事件类型
+enum class PhysicsEventType : std::uint8_t {
+    Contact,                            // 两球相撞并施加了冲量
+    Stop,                               // 球体在本步停下
+    SpecialTrigger                      // 特殊球停下并触发了推动效果
+};
+
+constexpr std::uint32_t PHYSICS_EVENT_NO_BODY = UINT32_MAX;  // 事件不涉及第二个球体
+
+// 物理事件（16 字节的纯数据）：
+//   Contact        a、b 为两球的存储下标，value 为碰撞前沿法线方向的接近速度
+//   Stop           a 为停下的球体
+//   SpecialTrigger a 为特殊球，value 为被推动的球体数
+struct PhysicsEvent {
+    PhysicsEventType type = PhysicsEventType::Contact;
+    std::uint32_t a = 0;
+    std::uint32_t b = PHYSICS_EVENT_NO_BODY;
+    float value = 0.f;
+};
+
+// 每步的物理事件流：物理循环只往预先分配好的数组末尾追加纯数据，
+// 音效、计分、回放和统计在步后按顺序读取，物理循环本身不调用任何回调。
+// 同一步内的顺序固定：扫掠碰撞、停止与特殊效果（按下标）、离散碰撞（按检测顺序），与线程数无关
+class PhysicsEventStream {
+public:
+    static constexpr std::size_t EVENTS_PER_BODY = 4;  // 按球体数预留的事件容量
+
+    // 按球体数预留容量，正常情况下模拟过程中不再分配内存
+    void reserve(std::size_t bodyCount) {
+        events.reserve(bodyCount * EVENTS_PER_BODY);
+    }
+
+    // 开始新的一步（保留容量）
+    void clear() {
+        events.clear();
+        counts.fill(0);
+    }
+
+    void contact(std::uint32_t a, std::uint32_t b, float impactSpeed) {
+        push({PhysicsEventType::Contact, a, b, impactSpeed});
+    }
+
+    void stop(std::uint32_t body) {
+        push({PhysicsEventType::Stop, body, PHYSICS_EVENT_NO_BODY, 0.f});
+    }
+
+    void specialTrigger(std::uint32_t body, std::uint32_t pushed) {
+        push({PhysicsEventType::SpecialTrigger, body, PHYSICS_EVENT_NO_BODY, static_cast<float>(pushed)});
+    }
+
+    const PhysicsEvent* begin() const { return events.data(); }
+    const PhysicsEvent* end() const { return events.data() + events.size(); }
+    std::size_t size() const { return events.size(); }
+    bool empty() const { return events.empty(); }
+    const PhysicsEvent& operator[](std::size_t i) const { return events[i]; }
+
+    // 本步某类事件的数量
+    std::size_t count(PhysicsEventType type) const {
+        return counts[static_cast<std::size_t>(type)];
+    }
+
+private:
+    std::vector<PhysicsEvent> events;           // 本步的事件，按发生顺序
+    std::array<std::size_t, 3> counts{};        // 各类事件的数量
+
+    void push(const PhysicsEvent& event) {
+        events.push_back(event);
+        counts[static_cast<std::size_t>(event.type)]++;
+    }
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+// 可复现的随机数发生器：算法固定（SplitMix64 初始化 + xoshiro128**），
+// 只用整数运算，同一种子在任何平台和标准库上都产生相同的序列。
+// （std::rand 不可设定实现，std::uniform_*_distribution 在不同标准库中结果不同）
+class SimRandom {
+public:
+    explicit SimRandom(std::uint64_t seed = 0) {
+        reseed(seed);
+    }
+
+    void reseed(std::uint64_t seed) {
+        for (std::uint32_t& word : state) {
+            seed += 0x9E3779B97F4A7C15ull;
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            word = static_cast<std::uint32_t>(z ^ (z >> 31));
+        }
+    }
+
+    // 下一个 32 位随机数
+    std::uint32_t next() {
+        const std::uint32_t result = rotl(state[1] * 5u, 7) * 9u;
+        const std::uint32_t t = state[1] << 9;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 11);
+        return result;
+    }
+
+    // [0, bound) 内均匀分布的整数（拒绝采样，无取模偏差）
+    std::uint32_t below(std::uint32_t bound) {
+        if (bound == 0) return 0;
+        const std::uint32_t threshold = (0u - bound) % bound;
+        for (;;) {
+            const std::uint32_t r = next();
+            if (r >= threshold) return r % bound;
+        }
+    }
+
+    // [0, 1) 内的浮点数（24 位精度）
+    float uniform() {
+        return static_cast<float>(next() >> 8) * (1.f / 16777216.f);
+    }
+
+private:
+    std::uint32_t state[4] = {};
+
+    static std::uint32_t rotl(std::uint32_t x, int k) {
+        return (x << k) | (x >> (32 - k));
+    }
+};
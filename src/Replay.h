@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ByteStream.h"
+#include "MappedFile.h"
+#include "Physics.h"
+#include "SimulationClock.h"
+
+// 整局回放：模拟是确定性的，只需记录种子和每次击球的输入（在第几步、哪只鸟、目标点、蓄力时间），
+// 回放时从种子重新生成布局并在相同的步数施加相同的击球，得到逐位相同的整局过程。
+//
+// 回放文件格式（小端序）：
+//   文件头  16 字节  magic "BBRP"、版本 u16、保留 u16、头之后的字节数 u32、
+//           CRC32 u32（覆盖文件头前 12 字节和头之后的全部字节）
+//   内容    种子 u64、总步数 u32、击球数 u32，然后逐次击球：
+//           步数（与上一次击球的差值，变长整数）、鸟的编号 u8、目标点 x、y 和蓄力秒数三个 f32
+constexpr std::uint16_t REPLAY_VERSION = 2;                 // 2：模拟加入停止预测，旧回放不再逐位重现
+constexpr std::size_t REPLAY_MAX_BYTES = 1 << 20;           // 回放文件大小上限
+constexpr std::uint32_t REPLAY_MAX_SHOTS = 1 << 16;         // 单个回放中击球数量上限
+constexpr std::uint32_t REPLAY_KEYFRAME_INTERVAL = 240;     // 关键帧间隔（步），游戏中为 1 秒
+constexpr int REPLAY_MAX_STEPS_PER_UPDATE = 4096;           // 快进时单帧最多模拟的步数
+
+// 一次击球
+struct ReplayShot {
+    std::uint32_t step = 0;             // 在第几步之前发射（即已模拟的步数）
+    std::uint32_t player = 0;           // 鸟的编号（玩家组内下标）
+    float targetX = 0.f;                // 目标点
+    float targetY = 0.f;
+    float charge = 0.f;                 // 蓄力时间（秒）
+};
+
+// 整局的输入记录
+struct ReplayLog {
+    std::uint64_t seed = 0;             // 本局种子
+    std::uint32_t endStep = 0;          // 整局的总步数
+    std::vector<ReplayShot> shots;      // 按步数排列的击球
+};
+
+// 回放文件的编码和解码
+class ReplayFile {
+public:
+    static std::vector<std::uint8_t> encode(const ReplayLog& log) {
+        ByteWriter out;
+        out.bytes.reserve(HEADER_SIZE + 16 + log.shots.size() * 14);
+        out.bytes.insert(out.bytes.end(), MAGIC, MAGIC + 4);
+        out.u16(REPLAY_VERSION);
+        out.u16(0);
+        out.u32(0);                     // 头之后的字节数，最后回填
+        out.u32(0);                     // CRC32，最后回填
+
+        out.u64(log.seed);
+        out.u32(log.endStep);
+        out.u32(static_cast<std::uint32_t>(log.shots.size()));
+        std::uint32_t lastStep = 0;
+        for (const ReplayShot& shot : log.shots) {
+            out.varint(static_cast<std::int64_t>(shot.step) - lastStep);
+            out.u8(static_cast<std::uint8_t>(shot.player));
+            out.f32(shot.targetX);
+            out.f32(shot.targetY);
+            out.f32(shot.charge);
+            lastStep = shot.step;
+        }
+
+        out.patchU32(8, static_cast<std::uint32_t>(out.bytes.size() - HEADER_SIZE));
+        out.patchU32(12, checksum(out.bytes.data(), out.bytes.size()));
+        return std::move(out.bytes);
+    }
+
+    // 格式不对、校验失败或内容不合理（步数倒退、击球在结束之后）时返回 false（不修改 log）
+    static bool decode(const std::uint8_t* data, std::size_t size, ReplayLog& log) {
+        if (!data || size < HEADER_SIZE || size > REPLAY_MAX_BYTES) return false;
+        if (std::memcmp(data, MAGIC, 4) != 0) return false;
+        if (ByteReader::loadU16(data + 4) != REPLAY_VERSION) return false;
+        if (ByteReader::loadU32(data + 8) != size - HEADER_SIZE) return false;
+        if (checksum(data, size) != ByteReader::loadU32(data + 12)) return false;
+
+        ReplayLog loaded;
+        ByteReader in{data + HEADER_SIZE, data + size};
+        std::uint32_t count = 0;
+        if (!in.u64(loaded.seed) || !in.u32(loaded.endStep) || !in.u32(count)) return false;
+        if (count > REPLAY_MAX_SHOTS || static_cast<std::size_t>(count) * MIN_SHOT_BYTES > in.remaining()) {
+            return false;
+        }
+
+        loaded.shots.resize(count);
+        std::int64_t step = 0;
+        for (ReplayShot& shot : loaded.shots) {
+            std::int64_t delta = 0;
+            std::uint8_t player = 0;
+            if (!in.varint(delta) || !in.u8(player) || !in.f32(shot.targetX) || !in.f32(shot.targetY) ||
+                !in.f32(shot.charge)) {
+                return false;
+            }
+            step += delta;
+            if (delta < 0 || step > loaded.endStep) return false;
+            shot.step = static_cast<std::uint32_t>(step);
+            shot.player = player;
+        }
+
+        log = std::move(loaded);
+        return true;
+    }
+
+    static bool write(const std::string& path, const ReplayLog& log) {
+        const std::vector<std::uint8_t> bytes = encode(log);
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return static_cast<bool>(file);
+    }
+
+    static bool read(const std::string& path, ReplayLog& log) {
+        MappedFile file;
+        return file.open(path) && decode(file.data(), file.size(), log);
+    }
+
+private:
+    static constexpr char MAGIC[4] = {'B', 'B', 'R', 'P'};
+    static constexpr std::size_t HEADER_SIZE = 16;
+    static constexpr std::size_t MIN_SHOT_BYTES = 14;      // 步数差值至少 1 + 编号 1 + 三个 f32
+
+    // 跳过文件头中存放校验和本身的 4 个字节
+    static std::uint32_t checksum(const std::uint8_t* data, std::size_t size) {
+        return crc32(data + HEADER_SIZE, size - HEADER_SIZE, crc32(data, HEADER_SIZE - 4));
+    }
+};
+
+// 回放播放器：在给定的物理世界上按记录重新模拟，支持暂停、变速和跳转。
+// 每 REPLAY_KEYFRAME_INTERVAL 步保存一个关键帧（世界快照），跳转时从不晚于目标的最近关键帧
+// 开始模拟，不必每次从第 0 步开始；还没播放到的位置在跳转途中顺便补上关键帧
+class ReplayPlayer {
+public:
+    ReplayPlayer(PhysicsWorld& world, ReplayLog log)
+            : world(world), log(std::move(log)), clock(PHYSICS_STEP_RATE, REPLAY_MAX_STEPS_PER_UPDATE) {
+        restart();
+    }
+
+    // 从种子重新生成布局，回到第 0 步
+    void restart() {
+        world.clear();
+        world.spawnEnemies(log.seed);
+        world.spawnPlayers();
+        currentStep = 0;
+        nextShot = 0;
+        keyframes.resize(1);
+        world.saveSnapshot(keyframes[0]);
+        clock.reset();
+    }
+
+    // 按真实经过的时间乘以播放速度推进，每步之后调用 afterStep()（例如收集碰撞音效）。
+    // 暂停或播放完毕时什么也不做，返回本次模拟的步数
+    template <typename Fn>
+    int update(float elapsed, Fn&& afterStep) {
+        if (paused || finished()) return 0;
+        const int steps = std::min<std::uint32_t>(clock.advance(elapsed * speed), log.endStep - currentStep);
+        for (int i = 0; i < steps; ++i) {
+            advance();
+            afterStep();
+        }
+        if (finished()) clock.reset();
+        return steps;
+    }
+
+    int update(float elapsed) {
+        return update(elapsed, [] {});
+    }
+
+    // 跳转到第 step 步（超过总步数时跳到结尾），不受暂停影响
+    void seek(std::uint32_t step) {
+        step = std::min(step, log.endStep);
+        const std::size_t k = std::min<std::size_t>(step / REPLAY_KEYFRAME_INTERVAL, keyframes.size() - 1);
+        const std::uint32_t keyStep = static_cast<std::uint32_t>(k) * REPLAY_KEYFRAME_INTERVAL;
+        if (step < currentStep || keyStep > currentStep) {
+            world.restoreSnapshot(keyframes[k]);
+            currentStep = keyStep;
+            nextShot = static_cast<std::size_t>(
+                std::lower_bound(log.shots.begin(), log.shots.end(), currentStep,
+                                 [](const ReplayShot& shot, std::uint32_t s) { return shot.step < s; }) -
+                log.shots.begin());
+        }
+        while (currentStep < step) {
+            advance();
+        }
+        clock.reset();
+    }
+
+    void setPaused(bool value) { paused = value; }
+    bool isPaused() const { return paused; }
+    void setSpeed(float value) { speed = value; }
+    float getSpeed() const { return speed; }
+
+    std::uint32_t getStep() const { return currentStep; }
+    std::uint32_t getEndStep() const { return log.endStep; }
+    bool finished() const { return currentStep >= log.endStep; }
+    const ReplayLog& getLog() const { return log; }
+
+    // 渲染插值系数
+    float alpha() const { return clock.alpha(); }
+
+private:
+    PhysicsWorld& world;                    // 回放使用的物理世界（不持有）
+    ReplayLog log;                          // 整局的输入记录
+    SimulationClock clock;                  // 按播放速度切分物理步
+    std::vector<WorldSnapshot> keyframes;   // keyframes[k] 为第 k * REPLAY_KEYFRAME_INTERVAL 步的快照
+    std::uint32_t currentStep = 0;          // 已模拟的步数
+    std::size_t nextShot = 0;               // 下一次击球在 log.shots 中的下标
+    float speed = 1.f;                      // 播放速度（倍）
+    bool paused = false;                    // 是否暂停
+
+    // 施加本步的击球并模拟一步，到达关键帧位置时保存快照
+    void advance() {
+        while (nextShot < log.shots.size() && log.shots[nextShot].step == currentStep) {
+            const ReplayShot& shot = log.shots[nextShot++];
+            world.launchPlayer(shot.player, shot.targetX, shot.targetY, shot.charge);
+        }
+        world.step(clock.stepDt());
+        currentStep++;
+
+        if (currentStep % REPLAY_KEYFRAME_INTERVAL == 0 &&
+            currentStep / REPLAY_KEYFRAME_INTERVAL == keyframes.size()) {
+            keyframes.emplace_back();
+            world.saveSnapshot(keyframes.back());
+        }
+    }
+};
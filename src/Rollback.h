@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Physics.h"
+
+// 内存中的回退缓冲：按固定间隔和每次击球前保存世界快照，撤销、重试和从同一位置比较不同的击球
+// 都只需把快照拷回物理世界，不读写文件，也不重建渲染对象（球体数量不变）
+constexpr std::size_t ROLLBACK_CAPACITY = 64;               // 最多保留的快照数，满了覆盖最旧的
+constexpr std::uint32_t ROLLBACK_INTERVAL_STEPS = 240;      // 定时快照的间隔（步），游戏中为 1 秒
+
+// 一个快照及其上下文
+struct RollbackFrame {
+    WorldSnapshot world;                // 物理世界
+    std::uint32_t step = 0;             // 拍下时已模拟的步数
+    int shots = 0;                      // 拍下时的击球次数
+    bool shotPoint = false;             // 击球位置：击球之前（或起点）的快照，撤销和重试以它为准
+    int bestScore = -1;                 // 从这个位置出发的各次尝试中最好的分数，-1 表示还没有
+};
+
+// 固定容量的环形缓冲。帧的数组在覆盖时复用，容量填满之后保存快照不再分配内存；
+// 按“从新到旧的序号”访问，0 为最新的一帧
+class RollbackBuffer {
+public:
+    explicit RollbackBuffer(std::size_t capacity = ROLLBACK_CAPACITY) : frames(capacity) {}
+
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // 保存当前世界为最新的一帧，返回它以便调用方补充信息
+    RollbackFrame& push(const PhysicsWorld& world, std::uint32_t step, int shots, bool shotPoint) {
+        if (count == frames.size()) {
+            head = (head + 1) % frames.size();  // 覆盖最旧的一帧
+        } else {
+            count++;
+        }
+        RollbackFrame& frame = fromNewest(0);
+        world.saveSnapshot(frame.world);
+        frame.step = step;
+        frame.shots = shots;
+        frame.shotPoint = shotPoint;
+        frame.bestScore = -1;
+        return frame;
+    }
+
+    RollbackFrame& fromNewest(std::size_t i) {
+        return frames[(head + count - 1 - i) % frames.size()];
+    }
+
+    const RollbackFrame& fromNewest(std::size_t i) const {
+        return frames[(head + count - 1 - i) % frames.size()];
+    }
+
+    // 丢弃最新的 n 帧
+    void popNewest(std::size_t n = 1) {
+        count -= n < count ? n : count;
+    }
+
+    // 最近的击球位置的序号，没有时返回 size()
+    std::size_t latestShotPoint() const {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (fromNewest(i).shotPoint) return i;
+        }
+        return count;
+    }
+
+    // 早于第 step 步的最新一帧的序号，没有时返回 size()
+    std::size_t latestBefore(std::uint32_t step) const {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (fromNewest(i).step < step) return i;
+        }
+        return count;
+    }
+
+private:
+    std::vector<RollbackFrame> frames;  // 环形存放的帧
+    std::size_t head = 0;               // 最旧一帧的位置
+    std::size_t count = 0;              // 有效帧数
+};
@@ -0,0 +1,296 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "ByteStream.h"
+#include "MappedFile.h"
+#include "Physics.h"
+
+// 存档格式（所有整数均为小端序）：
+//
+//   文件头  16 字节  magic "BBSV"、版本 u16、段数 u16、头之后的字节数 u32、
+//           CRC32 u32（覆盖文件头前 12 字节和头之后的全部字节）
+//   段表    每段 12 字节：段编号 u32、段起点 u32（相对文件开头）、段长度 u32
+//   段数据  META   分数 i32、已发射次数 i32、额外击球次数 i32、本局种子 u64
+//           BODIES 敌方数 u32、玩家数 u32，然后按存储顺序逐个球体：
+//                  标志 u8、位置（量化到 1/256 像素，与上一个球体的差值，zigzag 变长整数）、
+//                  旋转 u16（一圈量化为 65536 份），有速度时再跟 vx、vy、角速度三个 f32
+//
+// 读取时把文件映射到内存后直接解析映射的字节；校验和、段表范围和球体数量都先检查，
+// 损坏或截断的文件被拒绝，不会按文件中的数量分配过大的数组。不认识的段被跳过
+constexpr std::uint16_t SAVE_VERSION = 1;
+constexpr std::size_t SAVE_MAX_BYTES = 1 << 20;     // 存档文件大小上限
+constexpr std::uint32_t SAVE_MAX_BODIES = 1 << 16;  // 单个存档中球体数量上限
+
+// 存档内容
+struct SaveState {
+    std::int32_t score = 0;             // 当前分数
+    std::int32_t shotsFired = 0;        // 已发射次数
+    std::int32_t extraShots = 0;        // 存档查看模式下的额外击球次数
+    std::uint64_t seed = 0;             // 本局种子
+    std::vector<Body> enemies;          // 敌方球体
+    std::vector<Body> players;          // 玩家球体
+};
+
+// 存档编码和解码（只依赖标准库）
+class SaveFile {
+public:
+    // 编码为完整的存档字节
+    static std::vector<std::uint8_t> encode(const SaveState& state) {
+        ByteWriter body;
+        body.u32(static_cast<std::uint32_t>(state.enemies.size()));
+        body.u32(static_cast<std::uint32_t>(state.players.size()));
+        std::int64_t lastX = 0, lastY = 0;
+        for (const std::vector<Body>* group : {&state.enemies, &state.players}) {
+            for (const Body& b : *group) {
+                writeBody(body, b, lastX, lastY);
+            }
+        }
+
+        ByteWriter meta;
+        meta.u32(static_cast<std::uint32_t>(state.score));
+        meta.u32(static_cast<std::uint32_t>(state.shotsFired));
+        meta.u32(static_cast<std::uint32_t>(state.extraShots));
+        meta.u64(state.seed);
+
+        const ByteWriter* sections[SECTION_COUNT] = {&meta, &body};
+        const std::uint32_t ids[SECTION_COUNT] = {SECTION_META, SECTION_BODIES};
+
+        ByteWriter out;
+        out.bytes.reserve(HEADER_SIZE + SECTION_COUNT * SECTION_ENTRY_SIZE + meta.bytes.size() + body.bytes.size());
+        out.bytes.insert(out.bytes.end(), MAGIC, MAGIC + 4);
+        out.u16(SAVE_VERSION);
+        out.u16(SECTION_COUNT);
+        out.u32(0);                     // 头之后的字节数，最后回填
+        out.u32(0);                     // CRC32，最后回填
+
+        std::uint32_t offset = HEADER_SIZE + SECTION_COUNT * SECTION_ENTRY_SIZE;
+        for (std::size_t s = 0; s < SECTION_COUNT; ++s) {
+            out.u32(ids[s]);
+            out.u32(offset);
+            out.u32(static_cast<std::uint32_t>(sections[s]->bytes.size()));
+            offset += static_cast<std::uint32_t>(sections[s]->bytes.size());
+        }
+        for (const ByteWriter* section : sections) {
+            out.bytes.insert(out.bytes.end(), section->bytes.begin(), section->bytes.end());
+        }
+
+        const std::size_t payload = out.bytes.size() - HEADER_SIZE;
+        out.patchU32(8, static_cast<std::uint32_t>(payload));
+        out.patchU32(12, checksum(out.bytes.data(), out.bytes.size()));
+        return std::move(out.bytes);
+    }
+
+    // 从内存中的存档字节解码，格式不对、校验失败或数据越界时返回 false（不修改 state）
+    static bool decode(const std::uint8_t* data, std::size_t size, SaveState& state) {
+        View view;
+        if (!view.open(data, size)) return false;
+
+        SaveState loaded;
+        loaded.score = view.score();
+        loaded.shotsFired = view.shotsFired();
+        loaded.extraShots = view.extraShots();
+        loaded.seed = view.seed();
+        loaded.enemies.reserve(view.enemyCount());
+        loaded.players.reserve(view.playerCount());
+        const bool ok = view.forEachBody([&](const Body& body) {
+            std::vector<Body>& group = loaded.enemies.size() < view.enemyCount() ? loaded.enemies : loaded.players;
+            group.push_back(body);
+        });
+        if (!ok) return false;
+
+        state = std::move(loaded);
+        return true;
+    }
+
+    // 写入存档文件
+    static bool write(const std::string& path, const SaveState& state) {
+        const std::vector<std::uint8_t> bytes = encode(state);
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return static_cast<bool>(file);
+    }
+
+    // 映射存档文件并直接从映射的字节解码
+    static bool read(const std::string& path, SaveState& state) {
+        MappedFile file;
+        return file.open(path) && decode(file.data(), file.size(), state);
+    }
+
+private:
+    static constexpr char MAGIC[4] = {'B', 'B', 'S', 'V'};
+    static constexpr std::size_t HEADER_SIZE = 16;
+    static constexpr std::size_t SECTION_ENTRY_SIZE = 12;
+    static constexpr std::size_t SECTION_COUNT = 2;
+    static constexpr std::uint32_t SECTION_META = 1;
+    static constexpr std::uint32_t SECTION_BODIES = 2;
+    static constexpr std::size_t MIN_BODY_BYTES = 5;        // 标志 1 + 两个位置差值各至少 1 + 旋转 2
+    static constexpr float POSITION_SCALE = 256.f;          // 位置量化：每像素 256 份
+    static constexpr std::int64_t POSITION_LIMIT = INT32_MAX;  // 量化后位置的绝对值上限
+
+    // 球体标志字节
+    enum : std::uint8_t {
+        SAVE_STOPPED = 1 << 0,
+        SAVE_SPECIAL = 1 << 1,
+        SAVE_TRIGGERED = 1 << 2,
+        SAVE_LAUNCHED = 1 << 3,
+        SAVE_MOVING = 1 << 7            // 后面跟着速度和角速度
+    };
+
+    static std::int64_t quantizePosition(float v) {
+        if (!std::isfinite(v)) return 0;
+        const float scaled = std::round(v * POSITION_SCALE);
+        return static_cast<std::int64_t>(std::clamp(scaled, -2147483520.f, 2147483520.f));
+    }
+
+    static void writeBody(ByteWriter& out, const Body& b, std::int64_t& lastX, std::int64_t& lastY) {
+        const bool moving = b.vx != 0.f || b.vy != 0.f || b.angularVelocity != 0.f;
+        out.u8(static_cast<std::uint8_t>((b.isStopped ? SAVE_STOPPED : 0) | (b.isSpecial ? SAVE_SPECIAL : 0) |
+                                         (b.hasTriggeredSpecial ? SAVE_TRIGGERED : 0) |
+                                         (b.hasBeenLaunched ? SAVE_LAUNCHED : 0) | (moving ? SAVE_MOVING : 0)));
+
+        const std::int64_t qx = quantizePosition(b.x);
+        const std::int64_t qy = quantizePosition(b.y);
+        out.varint(qx - lastX);
+        out.varint(qy - lastY);
+        lastX = qx;
+        lastY = qy;
+
+        const float turns = b.rotation / 360.f - std::floor(b.rotation / 360.f);
+        out.u16(static_cast<std::uint16_t>(static_cast<std::uint32_t>(std::lround(turns * 65536.f)) & 0xFFFF));
+
+        if (moving) {
+            out.f32(b.vx);
+            out.f32(b.vy);
+            out.f32(b.angularVelocity);
+        }
+    }
+
+    static bool readBody(ByteReader& in, Body& b, std::int64_t& lastX, std::int64_t& lastY) {
+        std::uint8_t flags = 0;
+        std::int64_t dx = 0, dy = 0;
+        std::uint16_t rotation = 0;
+        if (!in.u8(flags) || !in.varint(dx) || !in.varint(dy) || !in.u16(rotation)) return false;
+
+        lastX += dx;
+        lastY += dy;
+        if (std::abs(lastX) > POSITION_LIMIT || std::abs(lastY) > POSITION_LIMIT) return false;
+        b.x = static_cast<float>(lastX) / POSITION_SCALE;
+        b.y = static_cast<float>(lastY) / POSITION_SCALE;
+        b.rotation = rotation * (360.f / 65536.f);
+
+        b.isStopped = flags & SAVE_STOPPED;
+        b.isSpecial = flags & SAVE_SPECIAL;
+        b.hasTriggeredSpecial = flags & SAVE_TRIGGERED;
+        b.hasBeenLaunched = flags & SAVE_LAUNCHED;
+        b.vx = b.vy = b.angularVelocity = 0.f;
+        if (flags & SAVE_MOVING) {
+            return in.f32(b.vx) && in.f32(b.vy) && in.f32(b.angularVelocity);
+        }
+        return true;
+    }
+
+    // 整个文件的校验和：跳过文件头中存放校验和本身的 4 个字节
+    static std::uint32_t checksum(const std::uint8_t* data, std::size_t size) {
+        return crc32(data + HEADER_SIZE, size - HEADER_SIZE, crc32(data, HEADER_SIZE - 4));
+    }
+
+public:
+    // 存档视图：只校验文件头、校验和与段表，记录各段在字节中的位置，不复制也不分配内存。
+    // 分数、种子和球体数量可以直接读取；球体按需顺序解码（位置是差值编码）。
+    // 视图引用传入的字节（例如 MappedFile 的映射），字节失效后视图也失效
+    class View {
+    public:
+        // 校验并定位各段，格式不对、校验失败或数据越界时返回 false
+        bool open(const std::uint8_t* data, std::size_t size) {
+            valid = false;
+            if (!data || size < HEADER_SIZE || size > SAVE_MAX_BYTES) return false;
+            if (std::memcmp(data, MAGIC, 4) != 0) return false;
+            if (ByteReader::loadU16(data + 4) != SAVE_VERSION) return false;
+            const std::uint32_t sectionCount = ByteReader::loadU16(data + 6);
+            const std::uint32_t payload = ByteReader::loadU32(data + 8);
+            if (payload != size - HEADER_SIZE) return false;
+            if (checksum(data, size) != ByteReader::loadU32(data + 12)) return false;
+            if (sectionCount * SECTION_ENTRY_SIZE > payload) return false;
+
+            const std::uint8_t* meta = nullptr;
+            std::uint32_t metaSize = 0;
+            bodies = nullptr;
+            bodiesSize = 0;
+            for (std::uint32_t s = 0; s < sectionCount; ++s) {
+                const std::uint8_t* entry = data + HEADER_SIZE + s * SECTION_ENTRY_SIZE;
+                const std::uint32_t id = ByteReader::loadU32(entry);
+                const std::uint32_t offset = ByteReader::loadU32(entry + 4);
+                const std::uint32_t length = ByteReader::loadU32(entry + 8);
+                if (offset < HEADER_SIZE || offset > size || length > size - offset) return false;
+                if (id == SECTION_META) {
+                    meta = data + offset;
+                    metaSize = length;
+                } else if (id == SECTION_BODIES) {
+                    bodies = data + offset;
+                    bodiesSize = length;
+                }
+            }
+            if (!meta || !bodies) return false;
+
+            ByteReader metaReader{meta, meta + metaSize};
+            std::uint32_t score = 0, shotsFired = 0, extraShots = 0;
+            if (!metaReader.u32(score) || !metaReader.u32(shotsFired) || !metaReader.u32(extraShots) ||
+                !metaReader.u64(roundSeed)) {
+                return false;
+            }
+            scoreValue = static_cast<std::int32_t>(score);
+            shotsValue = static_cast<std::int32_t>(shotsFired);
+            extraValue = static_cast<std::int32_t>(extraShots);
+
+            // 用段长度核对数量（每个球体至少 MIN_BODY_BYTES 字节），调用方按数量分配时不会过大
+            ByteReader bodyReader{bodies, bodies + bodiesSize};
+            if (!bodyReader.u32(enemies) || !bodyReader.u32(players)) return false;
+            const std::uint64_t total = static_cast<std::uint64_t>(enemies) + players;
+            if (total > SAVE_MAX_BODIES || total * MIN_BODY_BYTES > bodyReader.remaining()) return false;
+
+            valid = true;
+            return true;
+        }
+
+        bool isValid() const { return valid; }
+        std::int32_t score() const { return scoreValue; }
+        std::int32_t shotsFired() const { return shotsValue; }
+        std::int32_t extraShots() const { return extraValue; }
+        std::uint64_t seed() const { return roundSeed; }
+        std::uint32_t enemyCount() const { return enemies; }
+        std::uint32_t playerCount() const { return players; }
+
+        // 按存储顺序（先敌方后玩家）解码每个球体并调用 fn(const Body&)，数据损坏时返回 false。
+        // 半径取 ENEMY_RADIUS 或 PLAYER_RADIUS（存档中不保存半径和质量）
+        template <typename Fn>
+        bool forEachBody(Fn&& fn) const {
+            if (!valid) return false;
+            ByteReader in{bodies + 8, bodies + bodiesSize};
+            std::int64_t lastX = 0, lastY = 0;
+            const std::uint64_t total = static_cast<std::uint64_t>(enemies) + players;
+            for (std::uint64_t i = 0; i < total; ++i) {
+                Body body(0.f, 0.f, i < enemies ? ENEMY_RADIUS : PLAYER_RADIUS);
+                if (!readBody(in, body, lastX, lastY)) return false;
+                fn(static_cast<const Body&>(body));
+            }
+            return true;
+        }
+
+    private:
+        bool valid = false;
+        const std::uint8_t* bodies = nullptr;   // BODIES 段（含开头的两个数量）
+        std::uint32_t bodiesSize = 0;
+        std::int32_t scoreValue = 0;
+        std::int32_t shotsValue = 0;
+        std::int32_t extraValue = 0;
+        std::uint64_t roundSeed = 0;
+        std::uint32_t enemies = 0;
+        std::uint32_t players = 0;
+    };
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "AssetLoader.h"
+#include "TextureManager.h"
+
+// 各场景共享的窗口和资源：整个程序只有一个窗口（一个 OpenGL 上下文）、一个纹理缓存和一份字体，
+// 切换场景时不会重新创建窗口或重复加载资源
+struct SceneContext {
+    sf::RenderWindow& window;           // 唯一的窗口
+    AssetLoader& assets;                // 后台资源加载
+    TextureManager& textures;           // 纹理缓存
+    const sf::Font& font;               // 字体
+};
+
+// 场景编号：场景通过 nextScene 请求切换，由 Application 负责创建
+enum class SceneId {
+    None,                               // 不切换
+    Menu,                               // 菜单（封面和说明页）
+    Play                                // 游戏
+};
+
+// 场景接口：Application 每帧把事件交给当前场景，再依次调用 update 和 render
+class Scene {
+public:
+    virtual ~Scene() = default;
+
+    // 处理一个输入事件（窗口关闭事件由 Application 处理）
+    virtual void handleEvent(const sf::Event& event) = 0;
+
+    // 推进 elapsed 秒
+    virtual void update(float elapsed) = 0;
+
+    // 绘制并显示一帧
+    virtual void render() = 0;
+
+    // 是否需要重绘；为 false 时 Application 阻塞等待下一个事件
+    virtual bool needsRedraw() const {
+        return true;
+    }
+
+    // 请求切换到的场景
+    virtual SceneId nextScene() const {
+        return SceneId::None;
+    }
+
+    // 离开场景（切换场景或关闭窗口）之前调用
+    virtual void onExit() {}
+};
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "JobSystem.h"
+#include "Physics.h"
+#include "Random.h"
+#include "SimulationClock.h"
+
+// 击球规划：在给定局面上随机抽取候选击球（哪只鸟、方向、蓄力），每个候选从局面快照完整模拟到
+// 所有球停止，取得分最高的一个。候选成批并行模拟，每批开始前检查时间预算，超时即返回目前最好的结果，
+// 可以在游戏进行中作为提示或电脑对手使用
+constexpr std::chrono::milliseconds PLANNER_BUDGET{50};    // 默认时间预算
+constexpr std::size_t PLANNER_BATCH_PER_THREAD = 2;        // 每批中每个线程的候选数
+constexpr int PLANNER_MAX_STEPS = 240 * 60;                // 单个候选的步数上限（一分钟游戏时间）
+constexpr int PLANNER_CHECK_INTERVAL = 32;                 // 模拟中每隔多少步检查超时
+constexpr float PLANNER_MIN_CHARGE = 0.3f;                 // 候选的最小蓄力（秒），更弱的击球几乎推不动敌方
+constexpr float PLANNER_AIM_DISTANCE = 100.f;              // 由方向换算目标点时的距离（与速度无关）
+constexpr float PLANNER_REFINE_ANGLE = 6.f;                // 在最好的候选附近细化时方向的扰动范围（度）
+constexpr float PLANNER_REFINE_CHARGE = 0.4f;              // 细化时蓄力的扰动范围（秒）
+
+// 规划结果，与 PhysicsWorld::launchPlayer 的参数相同
+struct ShotPlan {
+    bool found = false;                 // 是否有可发射的鸟并完成了至少一个候选
+    std::size_t player = 0;             // 鸟的编号（玩家组内下标，2、3 为特殊球）
+    float targetX = 0.f;                // 目标点
+    float targetY = 0.f;
+    float charge = 0.f;                 // 蓄力时间（秒）
+    int score = -1;                     // 模拟结束时的得分（中心区域外的敌方球体数）
+
+    // 统计
+    std::size_t candidates = 0;         // 完成模拟的候选数
+    std::uint64_t steps = 0;            // 所有候选的总步数
+    double milliseconds = 0.0;          // 实际耗时
+};
+
+class ShotPlanner {
+public:
+    // jobs 为空时在调用线程上逐个模拟
+    explicit ShotPlanner(JobSystem* jobs = nullptr) : jobs(jobs) {}
+
+    // 在 start 局面上为还没发射的鸟规划一次击球。相同的 seed 和局面按相同的顺序抽取候选；
+    // 完成多少批取决于机器速度，因此预算不同结果可能不同
+    ShotPlan plan(const WorldSnapshot& start, std::uint64_t seed,
+                  std::chrono::steady_clock::duration budget = PLANNER_BUDGET) {
+        const auto begin = std::chrono::steady_clock::now();
+        const auto deadline = begin + budget;
+        ShotPlan best;
+
+        std::vector<std::size_t> players;
+        for (std::size_t i = start.enemyCount; i < start.bodies.size(); ++i) {
+            if (!start.bodies.test(i, BODY_LAUNCHED)) players.push_back(i - start.enemyCount);
+        }
+        if (players.empty()) return best;
+
+        const std::size_t batch = (jobs ? jobs->threadCount() : 1) * PLANNER_BATCH_PER_THREAD;
+        if (scratch.size() < batch) scratch.resize(batch);
+        candidates.resize(batch);
+        const int enemies = static_cast<int>(start.enemyCount);
+
+        // 已经找到让所有敌方球体停在中心区域外的击球时不可能更好，不再抽取下一批
+        SimRandom random(seed);
+        while (std::chrono::steady_clock::now() < deadline && best.score < enemies) {
+            // 一半在整个范围内随机抽取，一半在目前最好的候选附近细化
+            for (std::size_t k = 0; k < batch; ++k) {
+                candidates[k] = best.found && (k & 1) ? refine(best, start, random) : sample(players, start, random);
+            }
+
+            auto evaluate = [&](std::size_t b, std::size_t e) {
+                for (std::size_t k = b; k < e; ++k) {
+                    simulate(scratch[k], start, candidates[k], deadline);
+                }
+            };
+            if (jobs) {
+                jobs->parallelFor(0, batch, 1, evaluate);
+            } else {
+                evaluate(0, batch);
+            }
+
+            // 按候选顺序合并，得分相同时保留先抽到的
+            for (const Candidate& candidate : candidates) {
+                best.steps += candidate.steps;
+                if (candidate.score < 0) continue;
+                best.candidates++;
+                if (candidate.score > best.score) {
+                    best.found = true;
+                    best.player = candidate.player;
+                    best.targetX = candidate.targetX;
+                    best.targetY = candidate.targetY;
+                    best.charge = candidate.charge;
+                    best.score = candidate.score;
+                }
+            }
+        }
+
+        best.milliseconds =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        return best;
+    }
+
+private:
+    // 一个候选击球及其模拟结果
+    struct Candidate {
+        std::size_t player = 0;
+        float angle = 0.f;              // 方向（度，0 为向右、-90 为向上）
+        float targetX = 0.f;
+        float targetY = 0.f;
+        float charge = 0.f;
+        int score = -1;                 // 超时未完成时为 -1
+        std::uint64_t steps = 0;
+    };
+
+    JobSystem* jobs;                        // 可选的任务系统（不持有）
+    std::vector<PhysicsWorld> scratch;      // 每个候选槽位一个物理世界，多次规划之间复用
+    std::vector<Candidate> candidates;      // 本批的候选
+
+    static void aim(Candidate& candidate, const WorldSnapshot& start) {
+        const std::size_t i = start.enemyCount + candidate.player;
+        const float radians = candidate.angle * 3.14159265f / 180.f;
+        candidate.targetX = start.bodies.x[i] + std::cos(radians) * PLANNER_AIM_DISTANCE;
+        candidate.targetY = start.bodies.y[i] + std::sin(radians) * PLANNER_AIM_DISTANCE;
+    }
+
+    // 鸟在场地下方，只朝上半平面发射
+    static Candidate sample(const std::vector<std::size_t>& players, const WorldSnapshot& start, SimRandom& random) {
+        Candidate candidate;
+        candidate.player = players[random.below(static_cast<std::uint32_t>(players.size()))];
+        candidate.angle = -180.f * random.uniform();
+        candidate.charge = PLANNER_MIN_CHARGE + (CHARGE_MAX_TIME - PLANNER_MIN_CHARGE) * random.uniform();
+        aim(candidate, start);
+        return candidate;
+    }
+
+    static Candidate refine(const ShotPlan& best, const WorldSnapshot& start, SimRandom& random) {
+        Candidate candidate;
+        candidate.player = best.player;
+        const std::size_t i = start.enemyCount + best.player;
+        const float bestAngle =
+            std::atan2(best.targetY - start.bodies.y[i], best.targetX - start.bodies.x[i]) * 180.f / 3.14159265f;
+        candidate.angle = bestAngle + (random.uniform() * 2.f - 1.f) * PLANNER_REFINE_ANGLE;
+        candidate.charge = std::clamp(best.charge + (random.uniform() * 2.f - 1.f) * PLANNER_REFINE_CHARGE,
+                                      PLANNER_MIN_CHARGE, CHARGE_MAX_TIME);
+        aim(candidate, start);
+        return candidate;
+    }
+
+    // 模拟一个候选直到所有球停止，按停止后的局面计分（飞出中心区域的球可能弹回来，中途不计分）。
+    // 超过截止时间或步数上限仍未停止时放弃（score 为 -1）；各候选互不影响
+    static void simulate(PhysicsWorld& world, const WorldSnapshot& start, Candidate& candidate,
+                         std::chrono::steady_clock::time_point deadline) {
+        const float dt = SimulationClock().stepDt();
+        world.restoreSnapshot(start);
+        world.settleDistance = SETTLE_HEADLESS_DISTANCE;
+        world.launchPlayer(candidate.player, candidate.targetX, candidate.targetY, candidate.charge);
+
+        candidate.score = -1;
+        candidate.steps = 0;
+        for (int s = 1; !world.allStopped(); ++s) {
+            if (s > PLANNER_MAX_STEPS) return;
+            world.step(dt);
+            candidate.steps++;
+            if (s % PLANNER_CHECK_INTERVAL == 0 && std::chrono::steady_clock::now() >= deadline) return;
+        }
+        candidate.score = world.countEnemiesOutsideZone();
+    }
+};
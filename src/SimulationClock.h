@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include "Physics.h"
+
+// 固定步长模拟时钟：累加真实经过的时间，按固定频率切分成物理步，
+// 剩余不足一步的时间作为渲染插值系数，使物理速度与帧率无关
+class SimulationClock {
+public:
+    // stepRate：每秒物理步数；maxStepsPerFrame：单帧最多补算的步数（防止卡顿后雪崩）
+    explicit SimulationClock(float stepRate = PHYSICS_STEP_RATE, int maxStepsPerFrame = 16)
+            : stepSeconds(1.f / stepRate), maxStepsPerFrame(maxStepsPerFrame) {}
+
+    // 累加本帧经过的真实时间，返回本帧需要执行的物理步数
+    int advance(float elapsedSeconds) {
+        accumulator += elapsedSeconds;
+        int steps = static_cast<int>(accumulator / stepSeconds);
+        if (steps > maxStepsPerFrame) {
+            // 落后太多时丢弃多余的时间，宁可变慢也不卡死
+            steps = maxStepsPerFrame;
+            accumulator = stepSeconds * static_cast<float>(steps);
+        }
+        accumulator -= stepSeconds * static_cast<float>(steps);
+        return steps;
+    }
+
+    // 清空累积时间（状态切换、读档后调用）
+    void reset() {
+        accumulator = 0.f;
+    }
+
+    // 每步的物理步长（PHYSICS_DT 对应 1/PHYSICS_DT_RATE 秒）
+    float stepDt() const {
+        return PHYSICS_DT * stepSeconds * PHYSICS_DT_RATE;
+    }
+
+    // 渲染插值系数：上一步到下一步之间已经过去的比例
+    float alpha() const {
+        return std::clamp(accumulator / stepSeconds, 0.f, 1.f);
+    }
+
+private:
+    float stepSeconds;          // 每步的真实时长（秒）
+    int maxStepsPerFrame;       // 单帧最多执行的步数
+    float accumulator = 0.f;    // 尚未模拟的真实时间（秒）
+};
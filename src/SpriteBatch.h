@@ -0,0 +1,179 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+
+// 纹理图集：把多张小图排进同一张纹理，绘制时只用纹理坐标区分。
+// 另外保留一小块纯白区域，纯色矩形（边框、蓄力条等）也可以用同一张纹理绘制
+class TextureAtlas {
+public:
+    // 从图片文件构建图集，任何一张加载失败时返回 false
+    bool loadFromFiles(const std::vector<std::string>& files) {
+        std::vector<sf::Image> decoded(files.size());
+        std::vector<const sf::Image*> sources;
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (!decoded[i].loadFromFile(files[i])) return false;
+            sources.push_back(&decoded[i]);
+        }
+        return loadFromImages(files, sources);
+    }
+
+    // 从已解码的图片构建图集，names[i] 为 sources[i] 的区域名
+    bool loadFromImages(const std::vector<std::string>& names, const std::vector<const sf::Image*>& sources) {
+        std::vector<const sf::Image*> images = sources;
+        sf::Image whiteBlock;
+        whiteBlock.create(WHITE_SIZE, WHITE_SIZE, sf::Color::White);
+        images.push_back(&whiteBlock);
+
+        // 按高度从高到低逐行排放（shelf packing），图片之间留出间隔防止采样时串色
+        std::vector<size_t> order(images.size());
+        std::iota(order.begin(), order.end(), size_t{0});
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return images[a]->getSize().y > images[b]->getSize().y;
+        });
+
+        unsigned area = 0, widest = 0;
+        for (const sf::Image* image : images) {
+            area += (image->getSize().x + PADDING) * (image->getSize().y + PADDING);
+            widest = std::max(widest, image->getSize().x + PADDING);
+        }
+        unsigned width = 64;
+        while (width < widest || width * width < area) width *= 2;
+
+        std::vector<sf::Vector2u> placed(images.size());
+        unsigned shelfX = 0, shelfY = 0, shelfHeight = 0;
+        for (size_t i : order) {
+            const sf::Vector2u size = images[i]->getSize();
+            if (shelfX + size.x + PADDING > width) {
+                shelfY += shelfHeight;
+                shelfX = 0;
+                shelfHeight = 0;
+            }
+            placed[i] = sf::Vector2u(shelfX, shelfY);
+            shelfX += size.x + PADDING;
+            shelfHeight = std::max(shelfHeight, size.y + PADDING);
+        }
+        const unsigned height = shelfY + shelfHeight;
+        if (width > sf::Texture::getMaximumSize() || height > sf::Texture::getMaximumSize()) return false;
+
+        sf::Image atlas;
+        atlas.create(width, height, sf::Color::Transparent);
+        regions.clear();
+        for (size_t i = 0; i < images.size(); ++i) {
+            atlas.copy(*images[i], placed[i].x, placed[i].y);
+            const sf::Vector2u size = images[i]->getSize();
+            const sf::FloatRect rect(static_cast<float>(placed[i].x), static_cast<float>(placed[i].y),
+                                     static_cast<float>(size.x), static_cast<float>(size.y));
+            if (i < names.size()) {
+                regions[names[i]] = rect;
+            } else {
+                // 只取白色区域的中心，线性过滤时也不会采到边缘
+                white = sf::FloatRect(rect.left + WHITE_SIZE / 2.f, rect.top + WHITE_SIZE / 2.f, 0.f, 0.f);
+            }
+        }
+        if (!texture.loadFromImage(atlas)) return false;
+        texture.setSmooth(true);
+        return true;
+    }
+
+    const sf::Texture& getTexture() const {
+        return texture;
+    }
+
+    // 某个图片文件在图集中的区域（像素坐标）
+    sf::FloatRect getRegion(const std::string& file) const {
+        return regions.at(file);
+    }
+
+    // 纯白区域，配合顶点颜色绘制纯色矩形
+    sf::FloatRect getWhiteRegion() const {
+        return white;
+    }
+
+private:
+    static constexpr unsigned PADDING = 2;      // 图片之间的间隔（像素）
+    static constexpr unsigned WHITE_SIZE = 4;   // 纯白区域的边长（像素）
+
+    sf::Texture texture;                                // 整张图集纹理
+    std::map<std::string, sf::FloatRect> regions;       // 文件名 -> 图集中的区域
+    sf::FloatRect white;                                // 纯白区域
+};
+
+// 精灵批处理：每帧把所有使用同一图集的矩形（每个两个三角形）追加到一个顶点数组，
+// 再用一次 draw 调用画出，绘制次数不随球体数量增加
+class SpriteBatch {
+public:
+    explicit SpriteBatch(const TextureAtlas& atlas) : atlas(&atlas), vertices(sf::Triangles) {}
+
+    // 开始新的一帧（保留顶点数组的容量）
+    void clear() {
+        vertices.clear();
+    }
+
+    // 图集区域 region 缩放到 size，以 center 为中心旋转 rotation 度（与 sf::Sprite 相同，顺时针）
+    void addSprite(const sf::FloatRect& region, sf::Vector2f center, sf::Vector2f size, float rotation,
+                   sf::Color color = sf::Color::White) {
+        const float radians = rotation * 3.14159265f / 180.f;
+        const float c = std::cos(radians);
+        const float s = std::sin(radians);
+        const float hx = size.x / 2.f;
+        const float hy = size.y / 2.f;
+        auto corner = [&](float x, float y) {
+            return sf::Vector2f(center.x + x * c - y * s, center.y + x * s + y * c);
+        };
+        addQuad(corner(-hx, -hy), corner(hx, -hy), corner(hx, hy), corner(-hx, hy), region, color);
+    }
+
+    // 轴对齐的纯色矩形
+    void addRect(const sf::FloatRect& rect, sf::Color color) {
+        const float right = rect.left + rect.width;
+        const float bottom = rect.top + rect.height;
+        addQuad(sf::Vector2f(rect.left, rect.top), sf::Vector2f(right, rect.top),
+                sf::Vector2f(right, bottom), sf::Vector2f(rect.left, bottom), atlas->getWhiteRegion(), color);
+    }
+
+    // 矩形外侧宽 thickness 的边框（与 sf::RectangleShape 的正数描边相同）
+    void addOutline(const sf::FloatRect& rect, float thickness, sf::Color color) {
+        const float outerWidth = rect.width + thickness * 2;
+        addRect(sf::FloatRect(rect.left - thickness, rect.top - thickness, outerWidth, thickness), color);
+        addRect(sf::FloatRect(rect.left - thickness, rect.top + rect.height, outerWidth, thickness), color);
+        addRect(sf::FloatRect(rect.left - thickness, rect.top, thickness, rect.height), color);
+        addRect(sf::FloatRect(rect.left + rect.width, rect.top, thickness, rect.height), color);
+    }
+
+    // 一次绘制本帧的全部矩形
+    void draw(sf::RenderTarget& target) const {
+        sf::RenderStates states;
+        states.texture = &atlas->getTexture();
+        target.draw(vertices, states);
+    }
+
+    size_t quadCount() const {
+        return vertices.getVertexCount() / 6;
+    }
+
+private:
+    const TextureAtlas* atlas;          // 所有矩形共用的图集
+    sf::VertexArray vertices;           // 本帧的顶点（每个矩形 6 个）
+
+    // 四个角按顺时针给出，拆成两个三角形
+    void addQuad(sf::Vector2f topLeft, sf::Vector2f topRight, sf::Vector2f bottomRight, sf::Vector2f bottomLeft,
+                 const sf::FloatRect& region, sf::Color color) {
+        const sf::Vector2f uvTopLeft(region.left, region.top);
+        const sf::Vector2f uvTopRight(region.left + region.width, region.top);
+        const sf::Vector2f uvBottomRight(region.left + region.width, region.top + region.height);
+        const sf::Vector2f uvBottomLeft(region.left, region.top + region.height);
+
+        vertices.append(sf::Vertex(topLeft, color, uvTopLeft));
+        vertices.append(sf::Vertex(topRight, color, uvTopRight));
+        vertices.append(sf::Vertex(bottomRight, color, uvBottomRight));
+        vertices.append(sf::Vertex(topLeft, color, uvTopLeft));
+        vertices.append(sf::Vertex(bottomRight, color, uvBottomRight));
+        vertices.append(sf::Vertex(bottomLeft, color, uvBottomLeft));
+    }
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "AssetLoader.h"
+#include "SpriteBatch.h"
+
+// 缓存中的一张纹理及其引用计数
+struct TextureEntry {
+    sf::Texture texture;                // 已上传到显卡的纹理
+    int refCount = 0;                   // 持有该纹理的 TextureRef 数量
+};
+
+// 纹理引用：持有期间缓存不会清理对应的纹理（复制时引用计数加一，析构时减一）
+class TextureRef {
+public:
+    TextureRef() = default;
+    TextureRef(const TextureRef& other) : entry(other.entry) {
+        if (entry) entry->refCount++;
+    }
+    TextureRef& operator=(TextureRef other) {
+        std::swap(entry, other.entry);
+        return *this;
+    }
+    ~TextureRef() {
+        if (entry) entry->refCount--;
+    }
+
+    const sf::Texture& get() const {
+        return entry->texture;
+    }
+
+private:
+    friend class TextureManager;
+    explicit TextureRef(TextureEntry* e) : entry(e) {
+        entry->refCount++;
+    }
+
+    TextureEntry* entry = nullptr;
+};
+
+// 纹理缓存统计
+struct TextureCacheStats {
+    size_t hits = 0;                    // 命中缓存的次数
+    size_t misses = 0;                  // 需要从磁盘解码的次数
+    double decodeMilliseconds = 0.0;    // 主线程上解码（或等待后台解码）和上传的总耗时
+};
+
+// 纹理管理器类：负责加载和管理所有游戏纹理。
+// 每个文件只解码一次，之后返回同一个纹理（地址在清理前保持不变）
+class TextureManager {
+public:
+    // 提供 loader 时使用后台解码好的图片（主线程只负责上传），否则在主线程上同步解码
+    explicit TextureManager(AssetLoader* loader = nullptr) : loader(loader) {}
+
+    // 获取纹理并增加引用计数
+    TextureRef acquire(const std::string& filename) {
+        return TextureRef(&load(filename));
+    }
+
+    // 获取纹理但不持有引用（只在本管理器存活期间使用）
+    sf::Texture& getTexture(const std::string& filename) {
+        return load(filename).texture;
+    }
+
+    // 获取由若干图片文件打包成的图集（同一组文件只构建一次，图集不会被清理）
+    const TextureAtlas& getAtlas(const std::vector<std::string>& files) {
+        std::string key;
+        for (const std::string& file : files) key += file + '\n';
+        auto found = atlases.find(key);
+        if (found != atlases.end()) {
+            stats.hits++;
+            return found->second;
+        }
+
+        sf::Clock decodeClock;
+        auto& atlas = atlases[key];
+        if (!buildAtlas(atlas, files)) {
+            atlases.erase(key);
+            std::cerr << "Error building texture atlas from " << files.size() << " images" << std::endl;
+            throw std::runtime_error("Failed to build texture atlas!");
+        }
+        stats.misses++;
+        stats.decodeMilliseconds += decodeClock.getElapsedTime().asSeconds() * 1000.0;
+        return atlas;
+    }
+
+    // 释放所有没有被引用的纹理
+    void purgeUnused() {
+        for (auto it = textures.begin(); it != textures.end();) {
+            it = it->second.refCount == 0 ? textures.erase(it) : std::next(it);
+        }
+    }
+
+    const TextureCacheStats& getStats() const {
+        return stats;
+    }
+
+private:
+    // 存储容器（std::map 的节点地址稳定，插入新纹理不会使已有引用失效）
+    std::map<std::string, TextureEntry> textures;  // 纹理映射表
+    std::map<std::string, TextureAtlas> atlases;    // 图集（键为换行分隔的文件名）
+    TextureCacheStats stats;                        // 命中和解码统计
+    AssetLoader* loader;                            // 后台解码（可为空）
+
+    // 上传后释放后台解码的图片（纹理已在显卡上，之后命中缓存）
+    bool loadTexture(sf::Texture& texture, const std::string& filename) {
+        if (!loader) return texture.loadFromFile(filename);
+        bool ok = loader->uploadTexture(filename, texture);
+        loader->release(filename);
+        return ok;
+    }
+
+    bool buildAtlas(TextureAtlas& atlas, const std::vector<std::string>& files) {
+        if (!loader) return atlas.loadFromFiles(files);
+
+        // 先全部请求，让各图片在工作线程上并行解码
+        for (const std::string& file : files) loader->prefetchImage(file);
+        std::vector<const sf::Image*> images;
+        for (const std::string& file : files) {
+            const sf::Image* image = loader->image(file);
+            if (!image) return false;
+            images.push_back(image);
+        }
+        bool ok = atlas.loadFromImages(files, images);
+        for (const std::string& file : files) loader->release(file);
+        return ok;
+    }
+
+    TextureEntry& load(const std::string& filename) {
+        auto found = textures.find(filename);
+        if (found != textures.end()) {
+            stats.hits++;
+            return found->second;
+        }
+
+        sf::Clock decodeClock;
+        auto& entry = textures[filename];
+        if (!loadTexture(entry.texture, filename)) {
+            textures.erase(filename);
+            std::cerr << "Error loading texture from " << filename << std::endl;
+            throw std::runtime_error("Failed to load texture!");
+        }
+        stats.misses++;
+        stats.decodeMilliseconds += decodeClock.getElapsedTime().asSeconds() * 1000.0;
+        return entry;
+    }
+};
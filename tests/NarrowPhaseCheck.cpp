@@ -0,0 +1,104 @@
+// 窄相位一致性检查：各指令集版本（包括不自动选用的 AVX2）在密集球群和含边界值的随机候选对上
+// 与标量版本逐位比较距离平方和接近标记，任一不一致时打印第一个出错的对并返回非零。
+// 由 ctest 运行（NarrowPhaseAgreement）；只检查当前 CPU 支持的指令集。
+#include "Physics.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+// 密集球群：用空间哈希取出真实的候选对（大部分并不接触）
+BodyStore makeCluster(size_t count, std::vector<BodyPair>& pairs) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> jitter(-0.3f, 0.3f);
+    const size_t side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<float>(count))));
+    const float spacing = ENEMY_RADIUS * 2.2f;
+
+    BodyStore bodies;
+    for (size_t i = 0; i < count; ++i) {
+        bodies.insert(i, (static_cast<float>(i % side) + jitter(rng)) * spacing,
+                      (static_cast<float>(i / side) + jitter(rng)) * spacing, ENEMY_RADIUS, 1.f, 0);
+    }
+    SpatialHash hash;
+    hash.findPairs(bodies, pairs);
+    return bodies;
+}
+
+// 随机候选对，含重合、极大、极小和非正规数等边界值，数量不是 8 的倍数以覆盖尾部
+BodyStore makeFuzz(size_t count, std::vector<BodyPair>& pairs) {
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> position(-2000.f, 4000.f);
+    std::uniform_real_distribution<float> radius(0.f, 60.f);
+    const float specials[] = {0.f, -0.f, 1e-40f, -1e-40f, 1e19f, -1e19f, 3e38f,
+                              std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN()};
+
+    BodyStore bodies;
+    for (size_t i = 0; i < count; ++i) {
+        float x = position(rng), y = position(rng);
+        if (i % 17 == 0) x = specials[(i / 17) % std::size(specials)];
+        if (i % 23 == 0) y = specials[(i / 23) % std::size(specials)];
+        bodies.insert(i, x, y, radius(rng), 1.f, 0);
+    }
+    std::uniform_int_distribution<std::uint32_t> index(0, static_cast<std::uint32_t>(count - 1));
+    pairs.resize(count * 8 + 5);
+    for (BodyPair& p : pairs) {
+        p = {index(rng), index(rng)};
+    }
+    return bodies;
+}
+
+// 返回不一致的对数
+size_t checkAgreement(const BodyStore& bodies, const std::vector<BodyPair>& pairs, const char* name) {
+    const size_t count = pairs.size();
+    std::vector<float> expectedSquared(count), squared(count);
+    std::vector<std::uint8_t> expectedNear(count), near(count);
+    NarrowPhase::testPairs(bodies, pairs.data(), count, SLEEP_CONTACT_SLOP,
+                           expectedSquared.data(), expectedNear.data(), SimdLevel::Scalar);
+
+    size_t mismatches = 0;
+    for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2}) {
+        if (NarrowPhase::supportedLevel() < level) continue;
+        std::memset(squared.data(), 0xff, count * sizeof(float));
+        std::memset(near.data(), 0xff, count);
+        NarrowPhase::testPairs(bodies, pairs.data(), count, SLEEP_CONTACT_SLOP, squared.data(), near.data(), level);
+
+        size_t bad = 0;
+        for (size_t k = 0; k < count; ++k) {
+            if (std::memcmp(&squared[k], &expectedSquared[k], sizeof(float)) == 0 && near[k] == expectedNear[k]) {
+                continue;
+            }
+            if (bad++ == 0) {
+                std::printf("  第 %zu 对 (%u, %u): 距离平方 %a / 标量 %a，接近 %u / 标量 %u\n", k, pairs[k].a,
+                            pairs[k].b, squared[k], expectedSquared[k], near[k], expectedNear[k]);
+            }
+        }
+        std::printf("%-8s %-6s %8zu 对  %s\n", name, NarrowPhase::levelName(level), count,
+                    bad == 0 ? "逐位相同" : "不一致");
+        mismatches += bad;
+    }
+    return mismatches;
+}
+
+} // namespace
+
+int main() {
+    std::printf("CPU 支持 %s，物理世界默认使用 %s\n", NarrowPhase::levelName(NarrowPhase::supportedLevel()),
+                NarrowPhase::levelName(NarrowPhase::bestLevel()));
+
+    std::vector<BodyPair> clusterPairs, fuzzPairs;
+    const BodyStore cluster = makeCluster(20000, clusterPairs);
+    const BodyStore fuzz = makeFuzz(4099, fuzzPairs);
+
+    size_t mismatches = checkAgreement(cluster, clusterPairs, "密集球群");
+    mismatches += checkAgreement(fuzz, fuzzPairs, "随机边界");
+    if (mismatches > 0) {
+        std::printf("共 %zu 对与标量版本不一致\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,63 @@
+// 回放工具：无显示地快进播放回放文件，输出最终状态哈希和模拟速度。
+//
+// 用法: ReplayRun <回放文件> [--check]
+//   --check  顺序播放时记下每一步的哈希，再随机跳转（经由关键帧）若干次，
+//            核对跳转后的状态与顺序播放逐位相同，不一致时返回非零
+#include "Physics.h"
+#include "Random.h"
+#include "Replay.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "用法: %s <回放文件> [--check]\n", argv[0]);
+        return 2;
+    }
+    const bool check = argc > 2 && std::strcmp(argv[2], "--check") == 0;
+
+    ReplayLog log;
+    if (!ReplayFile::read(argv[1], log)) {
+        std::fprintf(stderr, "无法读取回放文件: %s\n", argv[1]);
+        return 2;
+    }
+
+    PhysicsWorld world;
+    ReplayPlayer player(world, log);
+    std::vector<std::uint64_t> hashes = {world.stateHash()};
+
+    // 顺序播放到结尾
+    const auto start = std::chrono::steady_clock::now();
+    while (!player.finished()) {
+        player.seek(player.getStep() + 1);
+        if (check) hashes.push_back(world.stateHash());
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const double simulated = player.getEndStep() / PHYSICS_STEP_RATE;
+    std::printf("种子 %llu  击球 %zu  步数 %u  最终哈希 %016llx\n", static_cast<unsigned long long>(log.seed),
+                log.shots.size(), player.getEndStep(), static_cast<unsigned long long>(world.stateHash()));
+    std::printf("耗时 %.2f ms  %.0f 步/秒  %.0f 倍实时\n", seconds * 1000.0,
+                seconds > 0 ? player.getEndStep() / seconds : 0.0, seconds > 0 ? simulated / seconds : 0.0);
+
+    if (check) {
+        SimRandom random(log.seed);
+        const int seeks = 64;
+        const auto seekStart = std::chrono::steady_clock::now();
+        for (int i = 0; i < seeks; ++i) {
+            const std::uint32_t target = random.below(player.getEndStep() + 1);
+            player.seek(target);
+            if (world.stateHash() != hashes[target]) {
+                std::printf("跳转到第 %u 步后哈希不一致\n", target);
+                return 1;
+            }
+        }
+        const double seekSeconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - seekStart).count();
+        std::printf("随机跳转 %d 次与顺序播放一致，平均每次 %.3f ms\n", seeks, seekSeconds * 1000.0 / seeks);
+    }
+    return 0;
+}
@@ -0,0 +1,122 @@
+// 存档扫描工具：批量检查存档文件（或目录下的所有文件），输出有效文件数、分数分布和扫描速度。
+// 每个文件只做内存映射和一次校验，分数、种子和球体数量直接从映射的字节读取，不复制文件内容。
+//
+// 用法: SaveScan [--list] [--bodies] <文件或目录>...
+//   --list    逐个输出文件的种子、分数、已发射次数和球体数量
+//   --bodies  同时逐个解码全部球体（完整校验），并统计中心区域外的敌方球体
+#include "SaveFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+struct ScanTotals {
+    std::size_t files = 0;              // 扫描的文件数
+    std::size_t valid = 0;              // 有效存档数
+    std::size_t bytes = 0;              // 有效存档的总字节数
+    std::size_t bodies = 0;             // 有效存档中的球体总数
+    std::size_t enemiesOutside = 0;     // 中心区域外的敌方球体（--bodies）
+    std::int64_t scoreSum = 0;
+    std::int32_t scoreMin = 0;
+    std::int32_t scoreMax = 0;
+};
+
+// 与 PhysicsWorld::countEnemiesOutsideZone 相同：球体完全离开中心区域才算
+bool outsideZone(const Body& body) {
+    return body.x + body.radius <= CENTER_ZONE_X || body.x - body.radius >= CENTER_ZONE_X + CENTER_ZONE_WIDTH ||
+           body.y + body.radius <= CENTER_ZONE_Y || body.y - body.radius >= CENTER_ZONE_Y + CENTER_ZONE_HEIGHT;
+}
+
+void scanFile(const std::string& path, bool list, bool decodeBodies, ScanTotals& totals) {
+    totals.files++;
+    MappedFile file;
+    SaveFile::View view;
+    if (!file.open(path) || !view.open(file.data(), file.size())) {
+        if (list) std::printf("%s  无效\n", path.c_str());
+        return;
+    }
+
+    std::size_t outside = 0;
+    if (decodeBodies) {
+        std::uint32_t index = 0;
+        const bool ok = view.forEachBody([&](const Body& body) {
+            if (index++ < view.enemyCount() && outsideZone(body)) outside++;
+        });
+        if (!ok) {
+            if (list) std::printf("%s  球体数据损坏\n", path.c_str());
+            return;
+        }
+    }
+
+    if (totals.valid == 0) {
+        totals.scoreMin = totals.scoreMax = view.score();
+    }
+    totals.valid++;
+    totals.bytes += file.size();
+    totals.bodies += view.enemyCount() + view.playerCount();
+    totals.enemiesOutside += outside;
+    totals.scoreSum += view.score();
+    totals.scoreMin = std::min(totals.scoreMin, view.score());
+    totals.scoreMax = std::max(totals.scoreMax, view.score());
+
+    if (list) {
+        std::printf("%s  种子 %llu  分数 %d  已发射 %d  敌方 %u  玩家 %u\n", path.c_str(),
+                    static_cast<unsigned long long>(view.seed()), view.score(), view.shotsFired(),
+                    view.enemyCount(), view.playerCount());
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool list = false, decodeBodies = false;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--list") == 0) {
+            list = true;
+        } else if (std::strcmp(argv[i], "--bodies") == 0) {
+            decodeBodies = true;
+        } else {
+            std::error_code error;
+            if (std::filesystem::is_directory(argv[i], error)) {
+                for (const auto& entry : std::filesystem::recursive_directory_iterator(argv[i], error)) {
+                    if (entry.is_regular_file()) files.push_back(entry.path().string());
+                }
+            } else {
+                files.push_back(argv[i]);
+            }
+        }
+    }
+    if (files.empty()) {
+        std::fprintf(stderr, "用法: %s [--list] [--bodies] <文件或目录>...\n", argv[0]);
+        return 2;
+    }
+    std::sort(files.begin(), files.end());
+
+    ScanTotals totals;
+    const auto start = std::chrono::steady_clock::now();
+    for (const std::string& path : files) {
+        scanFile(path, list, decodeBodies, totals);
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("文件 %zu  有效 %zu  无效 %zu  球体 %zu\n", totals.files, totals.valid, totals.files - totals.valid,
+                totals.bodies);
+    if (totals.valid > 0) {
+        std::printf("分数  最低 %d  最高 %d  平均 %.2f\n", totals.scoreMin, totals.scoreMax,
+                    static_cast<double>(totals.scoreSum) / totals.valid);
+    }
+    if (decodeBodies) {
+        std::printf("中心区域外的敌方球体 %zu\n", totals.enemiesOutside);
+    }
+    std::printf("耗时 %.3f ms  %.0f 文件/秒  %.1f MB/秒\n", seconds * 1000.0,
+                seconds > 0 ? totals.files / seconds : 0.0, seconds > 0 ? totals.bytes / seconds / 1e6 : 0.0);
+    return totals.valid == totals.files ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+// 复现工具：按种子生成对局，依次打出给定的击球，输出最终（或每一步的）状态哈希。
+// 每次击球在场上所有球停止后发出，与游戏中相同地使用固定步长 SimulationClock::stepDt()。
+//
+// 用法: SeedRun <种子> [--trace] [--check] [--record <文件>] [玩家,目标x,目标y,蓄力秒数]...
+//   --trace   输出每一步的状态哈希
+//   --check   同样的输入再模拟一遍，逐步核对哈希，不一致时返回非零
+//   --record  把这局写成回放文件（可用 ReplayRun 或游戏回放）
+#include "Physics.h"
+#include "Replay.h"
+#include "SimulationClock.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Shot {
+    std::size_t player = 0;
+    float targetX = 0.f;
+    float targetY = 0.f;
+    float charge = 0.f;
+};
+
+// 整局的物理事件统计
+struct EventTotals {
+    std::size_t contacts = 0;
+    std::size_t stops = 0;
+    std::size_t specialTriggers = 0;
+};
+
+// 模拟整局，返回每一步之后的状态哈希；replay 不为空时记录回放
+std::vector<std::uint64_t> simulate(std::uint64_t seed, const std::vector<Shot>& shots, EventTotals& totals,
+                                    ReplayLog* replay = nullptr) {
+    PhysicsWorld world;
+    world.spawnEnemies(seed);
+    world.spawnPlayers();
+
+    const float dt = SimulationClock().stepDt();
+    const int maxStepsPerShot = 1000000;
+    std::vector<std::uint64_t> hashes = {world.stateHash()};
+    for (const Shot& shot : shots) {
+        world.launchPlayer(shot.player, shot.targetX, shot.targetY, shot.charge);
+        if (replay) {
+            const std::uint32_t step = static_cast<std::uint32_t>(hashes.size() - 1);
+            replay->shots.push_back({step, static_cast<std::uint32_t>(shot.player), shot.targetX, shot.targetY,
+                                     shot.charge});
+        }
+        for (int s = 0; s < maxStepsPerShot && !world.allStopped(); ++s) {
+            world.step(dt);
+            hashes.push_back(world.stateHash());
+            totals.contacts += world.events.count(PhysicsEventType::Contact);
+            totals.stops += world.events.count(PhysicsEventType::Stop);
+            totals.specialTriggers += world.events.count(PhysicsEventType::SpecialTrigger);
+        }
+    }
+    if (replay) {
+        replay->seed = seed;
+        replay->endStep = static_cast<std::uint32_t>(hashes.size() - 1);
+    }
+    return hashes;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "用法: %s <种子> [--trace] [--check] [--record <文件>] [玩家,目标x,目标y,蓄力秒数]...\n",
+                     argv[0]);
+        return 2;
+    }
+
+    const std::uint64_t seed = std::strtoull(argv[1], nullptr, 10);
+    bool trace = false, check = false;
+    const char* recordFile = nullptr;
+    std::vector<Shot> shots;
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--trace") == 0) {
+            trace = true;
+        } else if (std::strcmp(argv[i], "--check") == 0) {
+            check = true;
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordFile = argv[++i];
+        } else {
+            Shot shot;
+            if (std::sscanf(argv[i], "%zu,%f,%f,%f", &shot.player, &shot.targetX, &shot.targetY, &shot.charge) != 4) {
+                std::fprintf(stderr, "无法解析击球参数: %s\n", argv[i]);
+                return 2;
+            }
+            shots.push_back(shot);
+        }
+    }
+
+    EventTotals totals;
+    ReplayLog replay;
+    const std::vector<std::uint64_t> hashes = simulate(seed, shots, totals, recordFile ? &replay : nullptr);
+    if (trace) {
+        for (std::size_t s = 0; s < hashes.size(); ++s) {
+            std::printf("%zu %016llx\n", s, static_cast<unsigned long long>(hashes[s]));
+        }
+    }
+    std::printf("种子 %llu  击球 %zu  步数 %zu  最终哈希 %016llx\n", static_cast<unsigned long long>(seed),
+                shots.size(), hashes.size() - 1, static_cast<unsigned long long>(hashes.back()));
+    std::printf("事件  碰撞 %zu  停止 %zu  特殊效果 %zu\n", totals.contacts, totals.stops, totals.specialTriggers);
+    if (recordFile) {
+        if (!ReplayFile::write(recordFile, replay)) {
+            std::fprintf(stderr, "无法写入回放文件: %s\n", recordFile);
+            return 1;
+        }
+        std::printf("回放已写入 %s\n", recordFile);
+    }
+
+    if (check) {
+        EventTotals againTotals;
+        const std::vector<std::uint64_t> again = simulate(seed, shots, againTotals);
+        for (std::size_t s = 0; s < std::max(hashes.size(), again.size()); ++s) {
+            if (s >= hashes.size() || s >= again.size() || hashes[s] != again[s]) {
+                std::printf("第 %zu 步哈希不一致\n", s);
+                return 1;
+            }
+        }
+        std::printf("两次模拟逐步一致\n");
+    }
+    return 0;
+}
@@ -0,0 +1,221 @@
+// 击球扫描工具：对一个种子生成的布局，按（方向角, 蓄力时间）网格逐个模拟一次击球，
+// 直到场上所有球停止，记录得分（中心区域外的敌方球体数），输出得分分布和每秒模拟次数。
+// 超过步数上限仍未全部停止的格子不计分，记为 UNSETTLED_SCORE（65535），单独统计数量。
+// 各次模拟互相独立，由任务系统分给所有核心；每次从同一个开局快照恢复，不重新生成布局。
+//
+// 用法: ShotSweep <种子> [选项]
+//   --player <编号>          发射的鸟（默认 0）
+//   --angles <最小,最大,数量>  方向角范围（度，0 为向右、-90 为向上，默认 -180,0,181）
+//   --charges <最小,最大,数量> 蓄力秒数范围（默认 0.1,CHARGE_MAX_TIME,20）
+//   --threads <数量>         线程数（默认全部硬件线程）
+//   --csv <文件>             写出 CSV 热力图：每行一个蓄力时间，每列一个方向角，未停止的格子为 65535
+//   --bin <文件>             写出二进制热力图（格式见 writeBinary）
+#include "ByteStream.h"
+#include "JobSystem.h"
+#include "Physics.h"
+#include "SimulationClock.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// 一个参数轴：从 min 到 max 均匀取 count 个值（含两端）
+struct Axis {
+    float min = 0.f;
+    float max = 0.f;
+    std::uint32_t count = 1;
+
+    float at(std::uint32_t i) const {
+        return count > 1 ? min + (max - min) * static_cast<float>(i) / static_cast<float>(count - 1) : min;
+    }
+};
+
+struct SweepResult {
+    std::vector<std::uint16_t> scores;  // 行主序：scores[charge * angles.count + angle]
+    std::uint64_t steps = 0;            // 所有模拟的总步数
+    std::size_t unsettled = 0;          // 达到步数上限仍未全部停止的模拟数
+};
+
+constexpr int MAX_STEPS_PER_SHOT = 240 * 120;   // 单次模拟的步数上限（两分钟游戏时间）
+constexpr std::size_t SWEEP_GRAIN = 4;          // 每个任务块的模拟次数
+constexpr float AIM_DISTANCE = 100.f;           // 由方向角换算目标点时的距离（与速度无关）
+constexpr std::uint16_t UNSETTLED_SCORE = 0xFFFF;  // 未停止的格子的得分标记
+
+bool parseAxis(const char* text, Axis& axis) {
+    return std::sscanf(text, "%f,%f,%u", &axis.min, &axis.max, &axis.count) == 3 && axis.count > 0;
+}
+
+SweepResult sweep(const WorldSnapshot& start, std::size_t player, const Axis& angles, const Axis& charges,
+                  JobSystem& jobs) {
+    SweepResult result;
+    const std::size_t cells = static_cast<std::size_t>(angles.count) * charges.count;
+    result.scores.resize(cells);
+    std::vector<std::uint64_t> chunkSteps((cells + SWEEP_GRAIN - 1) / SWEEP_GRAIN);
+
+    const float dt = SimulationClock().stepDt();
+    jobs.parallelFor(0, cells, SWEEP_GRAIN, [&](std::size_t begin, std::size_t end) {
+        PhysicsWorld world;
+        world.settleDistance = SETTLE_HEADLESS_DISTANCE;
+        std::uint64_t steps = 0;
+        for (std::size_t cell = begin; cell < end; ++cell) {
+            world.restoreSnapshot(start);
+            const std::size_t i = world.playerIndex(player);
+            const float radians = angles.at(static_cast<std::uint32_t>(cell % angles.count)) * 3.14159265f / 180.f;
+            world.launchPlayer(player, world.bodies.x[i] + std::cos(radians) * AIM_DISTANCE,
+                               world.bodies.y[i] + std::sin(radians) * AIM_DISTANCE,
+                               charges.at(static_cast<std::uint32_t>(cell / angles.count)));
+            int s = 0;
+            for (; s < MAX_STEPS_PER_SHOT && !world.allStopped(); ++s) {
+                world.step(dt);
+            }
+            steps += s;
+            result.scores[cell] = world.allStopped() ? static_cast<std::uint16_t>(world.countEnemiesOutsideZone())
+                                                     : UNSETTLED_SCORE;
+        }
+        chunkSteps[begin / SWEEP_GRAIN] = steps;
+    });
+    for (std::uint64_t steps : chunkSteps) result.steps += steps;
+    result.unsettled = static_cast<std::size_t>(std::count(result.scores.begin(), result.scores.end(), UNSETTLED_SCORE));
+    return result;
+}
+
+bool writeCsv(const std::string& path, const Axis& angles, const Axis& charges, const SweepResult& result) {
+    std::ofstream file(path, std::ios::trunc);
+    file << "charge/angle";
+    for (std::uint32_t a = 0; a < angles.count; ++a) file << ',' << angles.at(a);
+    file << '\n';
+    for (std::uint32_t c = 0; c < charges.count; ++c) {
+        file << charges.at(c);
+        for (std::uint32_t a = 0; a < angles.count; ++a) file << ',' << result.scores[c * angles.count + a];
+        file << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+// 二进制热力图（小端序）：magic "BBSW"、种子 u64、鸟的编号 u32、
+// 方向角和蓄力两个轴各为 最小 f32、最大 f32、数量 u32，然后行主序的得分 u16（未停止的格子为 0xFFFF），
+// 最后是前面全部字节的 CRC32
+bool writeBinary(const std::string& path, std::uint64_t seed, std::size_t player, const Axis& angles,
+                 const Axis& charges, const SweepResult& result) {
+    ByteWriter out;
+    out.bytes.reserve(40 + result.scores.size() * 2);
+    for (char c : {'B', 'B', 'S', 'W'}) out.u8(static_cast<std::uint8_t>(c));
+    out.u64(seed);
+    out.u32(static_cast<std::uint32_t>(player));
+    for (const Axis* axis : {&angles, &charges}) {
+        out.f32(axis->min);
+        out.f32(axis->max);
+        out.u32(axis->count);
+    }
+    for (std::uint16_t score : result.scores) out.u16(score);
+    out.u32(crc32(out.bytes.data(), out.bytes.size()));
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(out.bytes.data()), static_cast<std::streamsize>(out.bytes.size()));
+    return static_cast<bool>(file);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    // 种子必须是十进制数字（strtoull 对 --help 之类的文本会返回 0）
+    char* seedEnd = nullptr;
+    const std::uint64_t seed = argc < 2 ? 0 : std::strtoull(argv[1], &seedEnd, 10);
+    if (argc < 2 || !std::isdigit(static_cast<unsigned char>(argv[1][0])) || *seedEnd != '\0') {
+        std::fprintf(stderr,
+                     "用法: %s <种子> [--player <编号>] [--angles 最小,最大,数量] [--charges 最小,最大,数量] "
+                     "[--threads <数量>] [--csv <文件>] [--bin <文件>]\n",
+                     argv[0]);
+        return 2;
+    }
+    std::size_t player = 0;
+    unsigned threads = 0;
+    Axis angles{-180.f, 0.f, 181};
+    Axis charges{0.1f, CHARGE_MAX_TIME, 20};
+    const char* csvFile = nullptr;
+    const char* binFile = nullptr;
+    for (int i = 2; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--player") == 0 && hasValue) {
+            player = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--angles") == 0 && hasValue && parseAxis(argv[i + 1], angles)) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--charges") == 0 && hasValue && parseAxis(argv[i + 1], charges)) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--csv") == 0 && hasValue) {
+            csvFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--bin") == 0 && hasValue) {
+            binFile = argv[++i];
+        } else {
+            std::fprintf(stderr, "无法解析参数: %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    PhysicsWorld world;
+    world.spawnEnemies(seed);
+    world.spawnPlayers();
+    if (player >= world.playerCount()) {
+        std::fprintf(stderr, "没有编号为 %zu 的鸟\n", player);
+        return 2;
+    }
+    WorldSnapshot start;
+    world.saveSnapshot(start);
+
+    JobSystem jobs(threads);
+    const auto begin = std::chrono::steady_clock::now();
+    const SweepResult result = sweep(start, player, angles, charges, jobs);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    // 得分分布和最好的击球（只统计停止的格子）
+    const std::size_t cells = result.scores.size();
+    std::size_t best = cells;
+    for (std::size_t cell = 0; cell < cells; ++cell) {
+        if (result.scores[cell] != UNSETTLED_SCORE && (best == cells || result.scores[cell] > result.scores[best])) {
+            best = cell;
+        }
+    }
+    const std::uint16_t maxScore = best < cells ? result.scores[best] : 0;
+    std::vector<std::size_t> histogram(maxScore + 1);
+    for (std::uint16_t score : result.scores) {
+        if (score != UNSETTLED_SCORE) histogram[score]++;
+    }
+
+    std::printf("种子 %llu  鸟 %zu  网格 %u 个方向 x %u 档蓄力 = %zu 次模拟  %u 线程\n",
+                static_cast<unsigned long long>(seed), player, angles.count, charges.count, cells,
+                jobs.threadCount());
+    if (best < cells) {
+        std::printf("最高得分 %u  方向 %.2f 度  蓄力 %.3f 秒\n", maxScore,
+                    angles.at(static_cast<std::uint32_t>(best % angles.count)),
+                    charges.at(static_cast<std::uint32_t>(best / angles.count)));
+    }
+    std::printf("得分分布");
+    for (std::size_t score = 0; score < histogram.size(); ++score) {
+        if (histogram[score] > 0) std::printf("  %zu:%zu", score, histogram[score]);
+    }
+    std::printf("\n");
+    std::printf("耗时 %.2f ms  %.0f 次模拟/秒  %.0f 步/秒  平均每次 %.0f 步  未停止 %zu 次\n", seconds * 1000.0,
+                seconds > 0 ? cells / seconds : 0.0, seconds > 0 ? result.steps / seconds : 0.0,
+                static_cast<double>(result.steps) / cells, result.unsettled);
+
+    if (csvFile && !writeCsv(csvFile, angles, charges, result)) {
+        std::fprintf(stderr, "无法写入 %s\n", csvFile);
+        return 1;
+    }
+    if (binFile && !writeBinary(binFile, seed, player, angles, charges, result)) {
+        std::fprintf(stderr, "无法写入 %s\n", binFile);
+        return 1;
+    }
+    return 0;
+}